@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Benchmark
+import FlutterSwift
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+// Each iteration is a single round trip, over a FlutterLoopbackMessenger, so
+// that the latency percentiles are those of one message through the channel's
+// encode, dispatch and decode on both sides.
+private let channelConfiguration = Benchmark.Configuration(scalingFactor: .one)
+
+@FlutterPlatformThreadActor
+private func makeMethodChannel() throws -> FlutterMethodChannel {
+  let channel = FlutterMethodChannel(
+    name: "benchmark/method",
+    binaryMessenger: FlutterLoopbackMessenger()
+  )
+  try channel.setMethodCallHandler { (call: FlutterMethodCall<WindowArguments>) in
+    call.arguments
+  }
+  return channel
+}
+
+@FlutterPlatformThreadActor
+private func makeBasicMessageChannel() throws -> FlutterBasicMessageChannel {
+  let channel = FlutterBasicMessageChannel(
+    name: "benchmark/basic",
+    binaryMessenger: FlutterLoopbackMessenger()
+  )
+  try channel.setMessageHandler { (message: AnyFlutterStandardCodable?) in
+    message
+  }
+  return channel
+}
+
+func channelBenchmarks() {
+  Benchmark("FlutterMethodChannel/invoke round trip", configuration: channelConfiguration) {
+    benchmark in
+    let channel = try await makeMethodChannel()
+    benchmark.startMeasurement()
+    for _ in benchmark.scaledIterations {
+      let reply: WindowArguments? = try await channel.invoke(
+        method: "echo",
+        arguments: WindowArguments.sample
+      )
+      blackHole(reply)
+    }
+  }
+
+  Benchmark(
+    "FlutterBasicMessageChannel/send round trip",
+    configuration: channelConfiguration
+  ) { benchmark in
+    let channel = try await makeBasicMessageChannel()
+    benchmark.startMeasurement()
+    for _ in benchmark.scaledIterations {
+      try await blackHole(channel.send(message: scalarValue, reply: AnyFlutterStandardCodable.self))
+    }
+  }
+}
@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Benchmark
+import FlutterSwift
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+// Each codec benchmark encodes or decodes its value a thousand times per
+// iteration, so that the per-iteration overhead of the harness is lost in the
+// noise; results are reported per operation.
+private let codecConfiguration = Benchmark.Configuration(scalingFactor: .kilo)
+
+func standardCodecBenchmarks() {
+  // FlutterStandardEncoder is internal: its cost is measured through the
+  // codec, which adds only the copy out of the scratch buffer
+  let codec = FlutterStandardMessageCodec()
+
+  // MARK: - structs
+
+  Benchmark("FlutterStandardEncoder/struct, Codable", configuration: codecConfiguration) {
+    benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.encode(WindowArguments.sample))
+    }
+  }
+
+  Benchmark(
+    "FlutterStandardEncoder/struct, FlutterStandardEncodable",
+    configuration: codecConfiguration
+  ) { benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.encode(DirectWindowArguments.sample))
+    }
+  }
+
+  let windowArguments = try! codec.encode(WindowArguments.sample)
+
+  Benchmark("FlutterStandardDecoder/struct, Codable", configuration: codecConfiguration) {
+    benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.decode(windowArguments) as WindowArguments)
+    }
+  }
+
+  Benchmark(
+    "FlutterStandardDecoder/struct, FlutterStandardDecodable",
+    configuration: codecConfiguration
+  ) { benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.decode(windowArguments) as DirectWindowArguments)
+    }
+  }
+
+  // MARK: - AnyFlutterStandardCodable
+
+  let presizingCodec = FlutterStandardMessageCodec(presizesExactly: true)
+
+  Benchmark("AnyFlutterStandardCodable/write scalar list", configuration: codecConfiguration) {
+    benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.encode(scalarValue))
+    }
+  }
+
+  Benchmark("AnyFlutterStandardCodable/write nested map") { benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.encode(nestedValue))
+    }
+  }
+
+  Benchmark("AnyFlutterStandardCodable/write nested map, presized") { benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(presizingCodec.encode(nestedValue))
+    }
+  }
+
+  // Once the pool is warm, a direct write allocates only the `Data` it
+  // returns, and a `Codable` one adds its encoding state and containers:
+  // `baseline check` fails on any allocation added to either.
+  let pooledConfiguration = Benchmark.Configuration(
+    metrics: [.mallocCountTotal],
+    scalingFactor: .kilo,
+    thresholds: [.mallocCountTotal: .init(absolute: [.p50: 0, .p90: 0])]
+  )
+
+  Benchmark("FlutterStandardBufferPool/pooled write, direct", configuration: pooledConfiguration) {
+    benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.encode(scalarValue))
+    }
+  }
+
+  Benchmark("FlutterStandardBufferPool/pooled write, Codable", configuration: pooledConfiguration) {
+    benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.encode(WindowArguments.sample))
+    }
+  }
+
+  let scalarMessage = try! codec.encode(scalarValue)
+  let nestedMessage = try! codec.encode(nestedValue)
+
+  Benchmark("AnyFlutterStandardCodable/read scalar list", configuration: codecConfiguration) {
+    benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.decode(scalarMessage) as AnyFlutterStandardCodable)
+    }
+  }
+
+  Benchmark("AnyFlutterStandardCodable/read nested map") { benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.decode(nestedMessage) as AnyFlutterStandardCodable)
+    }
+  }
+
+  let internedCodec = FlutterStandardMessageCodec(stringInterner: FlutterStandardStringInterner())
+
+  Benchmark("AnyFlutterStandardCodable/read nested map, interned keys") { benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(internedCodec.decode(nestedMessage) as AnyFlutterStandardCodable)
+    }
+  }
+
+  // MARK: - strings
+
+  for corpus in stringCorpora {
+    let message = try! codec.encode(corpus.strings)
+
+    Benchmark("FlutterStandardDecoder/[String], \(corpus.name)") { benchmark in
+      for _ in benchmark.scaledIterations {
+        try blackHole(codec.decode(message) as [String])
+      }
+    }
+
+    Benchmark("FlutterStandardValueView/stringList(), \(corpus.name)") { benchmark in
+      for _ in benchmark.scaledIterations {
+        try blackHole(FlutterStandardValueView.withView(of: message) { try $0.stringList() })
+      }
+    }
+  }
+}
+
+func jsonCodecBenchmarks() {
+  let codec = FlutterJSONMessageCodec.shared
+  let message = try! codec.encode(WindowArguments.sample)
+
+  Benchmark("FlutterJSONMessageCodec/encode struct", configuration: codecConfiguration) {
+    benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.encode(WindowArguments.sample))
+    }
+  }
+
+  Benchmark("FlutterJSONMessageCodec/decode struct", configuration: codecConfiguration) {
+    benchmark in
+    for _ in benchmark.scaledIterations {
+      try blackHole(codec.decode(message) as WindowArguments)
+    }
+  }
+}
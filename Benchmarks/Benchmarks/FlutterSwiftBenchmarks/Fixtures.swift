@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import BinaryParsing
+import FlutterSwift
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/// A typical method-call argument struct, through the synthesized `Codable`
+/// conformance.
+struct WindowArguments: Codable, Sendable {
+  let id: Int
+  let width: Int32
+  let height: Int32
+  let scale: Double
+  let title: String
+  let subtitle: String?
+  let visible: Bool
+  let samples: [Float]
+
+  static let sample = WindowArguments(
+    id: 42,
+    width: 1920,
+    height: 1080,
+    scale: 1.5,
+    title: "Main window",
+    subtitle: nil,
+    visible: true,
+    samples: (0..<16).map { Float($0) }
+  )
+}
+
+/// The same struct, through hand-written `FlutterStandardEncodable` and
+/// `FlutterStandardDecodable` conformances that skip the containers.
+struct DirectWindowArguments: Codable, Sendable, FlutterStandardEncodable,
+  FlutterStandardDecodable
+{
+  let arguments: WindowArguments
+
+  init(_ arguments: WindowArguments) {
+    self.arguments = arguments
+  }
+
+  init(from decoder: any Decoder) throws {
+    arguments = try WindowArguments(from: decoder)
+  }
+
+  func encode(to encoder: any Encoder) throws {
+    try arguments.encode(to: encoder)
+  }
+
+  func write(to writer: inout FlutterStandardWriter) throws(FlutterSwiftError) {
+    writer.write(arguments.id)
+    writer.write(arguments.width)
+    writer.write(arguments.height)
+    writer.write(arguments.scale)
+    try writer.write(arguments.title)
+    if let subtitle = arguments.subtitle {
+      try writer.write(subtitle)
+    } else {
+      writer.writeNil()
+    }
+    writer.write(arguments.visible)
+    try writer.write(arguments.samples)
+  }
+
+  init(parsing input: inout ParserSpan) throws(ParsingError) {
+    let id = try Int(parsingStandard: &input)
+    let width = try Int32(parsingStandard: &input)
+    let height = try Int32(parsingStandard: &input)
+    let scale = try Double(parsingStandard: &input)
+    let title = try String(parsingStandard: &input)
+    let subtitle = try input.parseStandardNil() ? nil : String(parsingStandard: &input)
+    let visible = try Bool(parsingStandard: &input)
+    let samples = try [Float](parsingStandard: &input)
+    arguments = WindowArguments(
+      id: id,
+      width: width,
+      height: height,
+      scale: scale,
+      title: title,
+      subtitle: subtitle,
+      visible: visible,
+      samples: samples
+    )
+  }
+
+  static let sample = DirectWindowArguments(.sample)
+}
+
+/// A configuration-shaped value: a map of 64 entries, each a small map of
+/// scalars, a string and typed data.
+let nestedValue: AnyFlutterStandardCodable = .map(Dictionary(uniqueKeysWithValues: (0..<64)
+    .map { index in
+      (
+        AnyFlutterStandardCodable.string("entry\(index)"),
+        AnyFlutterStandardCodable.map([
+          .string("id"): .int32(Int32(index)),
+          .string("offset"): .int64(Int64(index) << 33),
+          .string("gain"): .float64(Double(index) * 0.25),
+          .string("label"): .string("channel \(index)"),
+          .string("enabled"): index.isMultiple(of: 2) ? .true : .false,
+          .string("levels"): .float64Data((0..<32).map { Double($0) }),
+        ])
+      )
+    }))
+
+/// A metering event, as sent many times a second on an event channel.
+let scalarValue: AnyFlutterStandardCodable = .list([.int32(7), .float64(-12.5)])
+
+/// Lists of 256 strings, for string decoding: ASCII only, mostly ASCII with
+/// some Latin-1 and emoji, and CJK throughout.
+let stringCorpora: [(name: String, strings: [String])] = [
+  ("ASCII", (0..<256).map { "parameter name \($0)" }),
+  ("mixed", (0..<256).map { "caf\u{E9} \($0) \u{1F3B5}" }),
+  ("CJK", (0..<256).map { "\u{97F3}\u{91CF}\u{8ABF}\u{6574} \($0)" }),
+]
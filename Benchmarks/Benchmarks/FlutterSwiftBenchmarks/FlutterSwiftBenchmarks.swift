@@ -0,0 +1,33 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Benchmark
+
+// Run from this directory with `swift package benchmark`. To catch a
+// regression, record a baseline on the base branch with
+// `swift package benchmark baseline update main` and compare against it with
+// `swift package benchmark baseline check main`.
+
+let benchmarks: @Sendable () -> () = {
+  Benchmark.defaultConfiguration = .init(
+    metrics: [.throughput, .wallClock, .mallocCountTotal],
+    maxDuration: .seconds(2)
+  )
+
+  standardCodecBenchmarks()
+  jsonCodecBenchmarks()
+  channelBenchmarks()
+}
@@ -0,0 +1,51 @@
+// swift-tools-version:6.2
+
+import PackageDescription
+
+// Kept out of the main package so that its consumers never resolve
+// package-benchmark (and its jemalloc dependency) or build it when
+// cross-compiling for eLinux and Android.
+
+var swiftSettings: [SwiftSetting] = [.enableExperimentalFeature("Lifetimes")]
+
+#if os(Linux)
+// FlutterSwift is built with C++ interoperability on Linux, and modules that
+// import it must be too
+swiftSettings += [.interoperabilityMode(.Cxx)]
+#endif
+
+let package = Package(
+  name: "FlutterSwiftBenchmarks",
+  platforms: [
+    .macOS(.v15),
+  ],
+  dependencies: [
+    .package(name: "FlutterSwift", path: ".."),
+    .package(url: "https://github.com/apple/swift-binary-parsing", from: "0.0.2"),
+    .package(url: "https://github.com/ordo-one/package-benchmark", from: "1.29.0"),
+  ],
+  targets: [
+    .executableTarget(
+      name: "FlutterSwiftBenchmarks",
+      dependencies: [
+        .product(name: "FlutterSwift", package: "FlutterSwift"),
+        // for the `FlutterStandardDecodable` fixtures
+        .product(name: "BinaryParsing", package: "swift-binary-parsing"),
+        .product(name: "Benchmark", package: "package-benchmark"),
+      ],
+      path: "Benchmarks/FlutterSwiftBenchmarks",
+      swiftSettings: swiftSettings,
+      plugins: [
+        .plugin(name: "BenchmarkPlugin", package: "package-benchmark"),
+      ]
+    ),
+    // open-loop load over FlutterLoopbackMessenger; see main.swift for usage
+    .executableTarget(
+      name: "FlutterSwiftLoad",
+      dependencies: [
+        .product(name: "FlutterSwift", package: "FlutterSwift"),
+      ],
+      swiftSettings: swiftSettings
+    ),
+  ]
+)
@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import FlutterSwift
+import Synchronization
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+struct LoadConfiguration: Sendable {
+  /// Channels driven at once, each with its own handler.
+  var channelCount = 8
+  /// Messages sent per second on each channel.
+  var messagesPerSecond = 1000
+  /// How long to send for; replies still outstanding are then awaited.
+  var duration: Duration = .seconds(5)
+  /// Bytes of `Uint8List` payload in each message.
+  var payloadSize = 256
+  /// Time each handler spends per message, standing in for real work.
+  var handlerTime: Duration = .zero
+}
+
+struct LoadReport: Sendable {
+  let configuration: LoadConfiguration
+  /// Messages that were replied to, and those that were not — discarded by a
+  /// channel buffer, or failed by their handler.
+  let repliedCount: Int
+  let unrepliedCount: Int
+  /// Time from the first send to the last reply.
+  let elapsed: Duration
+  /// Round-trip latencies of the replied messages, measured from when each
+  /// was scheduled to be sent, in ascending order.
+  let latencies: [Duration]
+
+  var throughput: Double {
+    Double(repliedCount) / elapsed.seconds
+  }
+
+  func latency(atPercentile percentile: Double) -> Duration {
+    guard !latencies.isEmpty else { return .zero }
+    let rank = Int((percentile / 100 * Double(latencies.count - 1)).rounded())
+    return latencies[rank]
+  }
+}
+
+/**
+ * Drives `FlutterBasicMessageChannel`s over a `FlutterLoopbackMessenger` at a
+ * fixed rate, and measures their round trips.
+ *
+ * Sending is open loop: each channel sends on a fixed schedule whether or not
+ * earlier messages have been replied to, as a Flutter app producing events
+ * would, so a handler that cannot keep up shows as growing latency rather
+ * than as a lower send rate.
+ */
+struct LoadGenerator {
+  let configuration: LoadConfiguration
+
+  func run() async throws -> LoadReport {
+    let messenger = FlutterLoopbackMessenger()
+    let channels = try await makeChannels(on: messenger)
+    let payload = AnyFlutterStandardCodable.uint8Data(
+      [UInt8](repeating: 0xA5, count: configuration.payloadSize)
+    )
+    let interval = Duration.seconds(1) / configuration.messagesPerSecond
+    let messageCount = Int(configuration.duration / interval)
+    let latencies = LatencyLog()
+    let clock = ContinuousClock()
+    let start = clock.now
+
+    try await withThrowingTaskGroup(of: Void.self) { group in
+      for channel in channels {
+        group.addTask {
+          try await withThrowingTaskGroup(of: Void.self) { sends in
+            for index in 0..<messageCount {
+              // latency counts from when the message was due, not when it got
+              // sent: a sender held up by a stalled handler, or by its own
+              // late wakeup, must not hide that delay from the percentiles
+              let due = start + interval * index
+              try await clock.sleep(until: due)
+              sends.addTask {
+                let reply = try await channel.send(
+                  message: payload,
+                  reply: AnyFlutterStandardCodable.self
+                )
+                guard reply != nil else { return }
+                let latency = due.duration(to: clock.now)
+                latencies.samples.withLock { $0.append(latency) }
+              }
+            }
+            try await sends.waitForAll()
+          }
+        }
+      }
+      try await group.waitForAll()
+    }
+    let elapsed = start.duration(to: clock.now)
+
+    let sorted = latencies.samples.withLock { $0.sorted() }
+    return LoadReport(
+      configuration: configuration,
+      repliedCount: sorted.count,
+      unrepliedCount: messageCount * channels.count - sorted.count,
+      elapsed: elapsed,
+      latencies: sorted
+    )
+  }
+
+  @FlutterPlatformThreadActor
+  private func makeChannels(
+    on messenger: FlutterLoopbackMessenger
+  ) throws -> [FlutterBasicMessageChannel] {
+    try (0..<configuration.channelCount).map { index in
+      let channel = FlutterBasicMessageChannel(
+        name: "load/\(index)",
+        binaryMessenger: messenger
+      )
+      let handlerTime = configuration.handlerTime
+      try channel.setMessageHandler { (message: AnyFlutterStandardCodable?) in
+        if handlerTime > .zero {
+          try? await Task.sleep(for: handlerTime)
+        }
+        return message
+      }
+      return channel
+    }
+  }
+}
+
+/// Shared by the send tasks, which cannot capture a `Mutex` directly.
+private final class LatencyLog: Sendable {
+  let samples = Mutex([Duration]())
+}
+
+extension Duration {
+  var seconds: Double {
+    let (seconds, attoseconds) = components
+    return Double(seconds) + Double(attoseconds) * 1e-18
+  }
+}
@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Usage: FlutterSwiftLoad [--channels N] [--rate MESSAGES_PER_SECOND]
+//                         [--duration SECONDS] [--payload BYTES]
+//                         [--handler-time MICROSECONDS]
+//
+// Exits with a non-zero status if any message went unreplied, so that a CI
+// job fails on it.
+
+#if canImport(Glibc)
+import Glibc
+#elseif canImport(Darwin)
+import Darwin
+#endif
+
+private func usage() -> Never {
+  print(
+    "usage: FlutterSwiftLoad [--channels N] [--rate MESSAGES_PER_SECOND] " +
+      "[--duration SECONDS] [--payload BYTES] [--handler-time MICROSECONDS]"
+  )
+  exit(2)
+}
+
+private func parseArguments() -> LoadConfiguration {
+  var configuration = LoadConfiguration()
+  var arguments = CommandLine.arguments.dropFirst()
+  while let option = arguments.popFirst() {
+    guard let value = arguments.popFirst().flatMap(Int.init), value >= 0 else { usage() }
+    switch option {
+    case "--channels": configuration.channelCount = max(value, 1)
+    case "--rate": configuration.messagesPerSecond = max(value, 1)
+    case "--duration": configuration.duration = .seconds(value)
+    case "--payload": configuration.payloadSize = value
+    case "--handler-time": configuration.handlerTime = .microseconds(value)
+    default: usage()
+    }
+  }
+  return configuration
+}
+
+private func milliseconds(_ duration: Duration) -> String {
+  let milliseconds = (duration.seconds * 1e6).rounded() / 1e3
+  return "\(milliseconds) ms"
+}
+
+let configuration = parseArguments()
+let report = try await LoadGenerator(configuration: configuration).run()
+
+print("""
+channels:    \(configuration.channelCount) at \(configuration.messagesPerSecond) msg/s, \
+\(configuration.payloadSize) byte payloads
+replied:     \(report.repliedCount) (\(report.unrepliedCount) unreplied)
+throughput:  \(Int(report.throughput)) msg/s
+latency:     p50 \(milliseconds(report.latency(atPercentile: 50))), \
+p99 \(milliseconds(report.latency(atPercentile: 99))), \
+p99.9 \(milliseconds(report.latency(atPercentile: 99.9))), \
+max \(milliseconds(report.latencies.last ?? .zero))
+""")
+
+exit(report.unrepliedCount == 0 ? 0 : 1)
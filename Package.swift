@@ -555,6 +555,8 @@ let package = Package(
       name: "FlutterSwiftTests",
       dependencies: [
         .target(name: "FlutterSwift"),
+        // `FlutterStandardDecodable` conformances parse from a `ParserSpan`
+        .product(name: "BinaryParsing", package: "swift-binary-parsing"),
       ],
       cxxSettings: platformCxxSettings,
       swiftSettings: platformSwiftSettings,
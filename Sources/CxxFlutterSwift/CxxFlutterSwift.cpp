@@ -14,12 +14,21 @@
 // limitations under the License.
 //
 
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
-#include <map>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 // FIXME: how can we include <Block/Block.h>
 extern "C" {
@@ -59,45 +68,174 @@ bool FlutterDesktopMessengerSendWithReplyBlock(
       replyBlock ? FlutterDesktopMessengerBinaryCleanupThunk : nullptr);
 }
 
-static std::map<std::string, const void *> flutterSwiftCallbacks{};
+// The engine copies every message into its own allocation before returning,
+// and the embedder API offers no way to write into that allocation, so the
+// segments are gathered here first: two copies, as for concatenating them.
+// The gathered message only has to live for the duration of the send, so a
+// buffer that grew past this is freed afterwards rather than kept per thread.
+static constexpr size_t kMaxRetainedSegmentBufferSize = 64 << 10;
+
+bool FlutterDesktopMessengerSendSegmentsWithReplyBlock(
+    FlutterDesktopMessengerRef messenger,
+    const char *channel,
+    const FlutterDesktopMessageSegment *segments,
+    const size_t segment_count,
+    FlutterDesktopBinaryReplyBlock replyBlock) {
+  if (segment_count <= 1) {
+    return FlutterDesktopMessengerSendWithReplyBlock(
+        messenger, channel, segment_count ? segments[0].data : nullptr,
+        segment_count ? segments[0].size : 0, replyBlock);
+  }
+
+  static thread_local std::vector<uint8_t> buffer;
+  size_t message_size = 0;
+  for (size_t i = 0; i < segment_count; i++) {
+    message_size += segments[i].size;
+  }
+  buffer.clear();
+  buffer.reserve(message_size);
+  for (size_t i = 0; i < segment_count; i++) {
+    if (segments[i].size > 0) {
+      buffer.insert(buffer.end(), segments[i].data,
+                    segments[i].data + segments[i].size);
+    }
+  }
+
+  auto sent = FlutterDesktopMessengerSendWithReplyBlock(
+      messenger, channel, buffer.empty() ? nullptr : buffer.data(),
+      buffer.size(), replyBlock);
+  if (buffer.capacity() > kMaxRetainedSegmentBufferSize) {
+    std::vector<uint8_t>().swap(buffer);
+  }
+  return sent;
+}
+
+int FlutterDesktopSharedMemoryCreate(const char *name, const size_t size) {
+  int fd = memfd_create(name, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0) {
+    return -1;
+  }
+  if (ftruncate(fd, size) < 0 ||
+      fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0) {
+    int saved_errno = errno;
+    close(fd);
+    errno = saved_errno;
+    return -1;
+  }
+  return fd;
+}
+
+void FlutterDesktopSetThreadName(const char *name) {
+  char truncated[16];
+  strncpy(truncated, name, sizeof(truncated) - 1);
+  truncated[sizeof(truncated) - 1] = '\0';
+  pthread_setname_np(pthread_self(), truncated);
+}
+
+int FlutterDesktopSetThreadAffinity(const int *cpus, const size_t count) {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (size_t i = 0; i < count; i++) {
+    if (cpus[i] < 0 || cpus[i] >= CPU_SETSIZE) {
+      return EINVAL;
+    }
+    CPU_SET(cpus[i], &set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// Owns the block copies registered with the engine's message dispatcher. The
+// dispatcher is handed the block itself as user_data, but may already have
+// done so when another thread replaces or removes the handler. So the thunk
+// retains the block under the lock, having checked that it is still
+// registered, and the replacing thread's release can never be the last one
+// while a message is being handled. The check is by pointer, so a message
+// costs an uncontended lock and no string allocation.
+static std::unordered_map<std::string, void *> flutterSwiftCallbacks{};
+static std::unordered_set<const void *> flutterSwiftLiveCallbacks{};
 static std::mutex flutterSwiftCallbacksMutex;
 
 static void
 FlutterDesktopMessageCallbackThunk(FlutterDesktopMessengerRef messenger,
                                    const FlutterDesktopMessage *message,
                                    void *user_data) {
-  auto callbackBlock = (FlutterDesktopMessageCallbackBlock)user_data;
-  callbackBlock(messenger, message);
+  void *callbackBlock = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(flutterSwiftCallbacksMutex);
+    if (flutterSwiftLiveCallbacks.count(user_data) != 0) {
+      callbackBlock = _Block_copy(user_data);
+    } else {
+      // replaced since the dispatcher looked it up: hand the message to the
+      // handler that replaced it, if any
+      auto it = flutterSwiftCallbacks.find(message->channel);
+      if (it != flutterSwiftCallbacks.end()) {
+        callbackBlock = _Block_copy(it->second);
+      }
+    }
+  }
+  if (callbackBlock == nullptr) {
+    // removed: reply, so that the engine frees the message
+    FlutterDesktopMessengerSendResponse(messenger, message->response_handle,
+                                        nullptr, 0);
+    return;
+  }
+  ((FlutterDesktopMessageCallbackBlock)callbackBlock)(messenger, message);
+  _Block_release(callbackBlock);
 }
 
 void FlutterDesktopMessengerSetCallbackBlock(
     FlutterDesktopMessengerRef messenger,
     const char *_Nonnull channel,
     FlutterDesktopMessageCallbackBlock callbackBlock) {
-  std::lock_guard<std::mutex> guard(flutterSwiftCallbacksMutex);
-  if (callbackBlock != nullptr) {
-    flutterSwiftCallbacks[channel] = _Block_copy(callbackBlock);
-    messenger->GetEngine()->message_dispatcher()->SetMessageCallback(
-        channel, FlutterDesktopMessageCallbackThunk, callbackBlock);
-  } else {
-    auto savedCallbackBlock = flutterSwiftCallbacks[channel];
-    flutterSwiftCallbacks.erase(channel);
+  void *savedCallbackBlock = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(flutterSwiftCallbacksMutex);
+    auto dispatcher = messenger->GetEngine()->message_dispatcher();
+    if (callbackBlock != nullptr) {
+      auto copiedCallbackBlock = _Block_copy(callbackBlock);
+      auto &slot = flutterSwiftCallbacks[channel];
+      // re-registering a channel replaces its handler; release the old copy
+      savedCallbackBlock = slot;
+      slot = copiedCallbackBlock;
+      flutterSwiftLiveCallbacks.insert(copiedCallbackBlock);
+      dispatcher->SetMessageCallback(
+          channel, FlutterDesktopMessageCallbackThunk, copiedCallbackBlock);
+    } else {
+      auto it = flutterSwiftCallbacks.find(channel);
+      if (it != flutterSwiftCallbacks.end()) {
+        savedCallbackBlock = it->second;
+        flutterSwiftCallbacks.erase(it);
+      }
+      dispatcher->SetMessageCallback(channel, nullptr, nullptr);
+    }
+    if (savedCallbackBlock != nullptr) {
+      flutterSwiftLiveCallbacks.erase(savedCallbackBlock);
+    }
+  }
+  // outside the lock: the last release runs the Swift closure's destructors.
+  // A thunk still running the old block holds its own reference.
+  if (savedCallbackBlock != nullptr) {
     _Block_release(savedCallbackBlock);
-    messenger->GetEngine()->message_dispatcher()->SetMessageCallback(
-        channel, nullptr, nullptr);
   }
 }
 
-static std::map<FlutterDesktopPluginRegistrarRef, const void *>
+static std::unordered_map<FlutterDesktopPluginRegistrarRef, void *>
     flutterSwiftRegistrarCallbacks{};
 static std::mutex flutterSwiftRegistrarCallbacksMutex;
 
 static void FlutterDesktopOnPluginRegistrarDestroyedBlockThunk(
     FlutterDesktopPluginRegistrarRef registrar) {
-  std::lock_guard<std::mutex> guard(flutterSwiftRegistrarCallbacksMutex);
-  auto callbackBlock = (FlutterDesktopOnPluginRegistrarDestroyedBlock)
-      flutterSwiftRegistrarCallbacks[registrar];
-  flutterSwiftRegistrarCallbacks.erase(registrar);
+  FlutterDesktopOnPluginRegistrarDestroyedBlock callbackBlock = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(flutterSwiftRegistrarCallbacksMutex);
+    auto it = flutterSwiftRegistrarCallbacks.find(registrar);
+    if (it == flutterSwiftRegistrarCallbacks.end()) {
+      return;
+    }
+    callbackBlock = (FlutterDesktopOnPluginRegistrarDestroyedBlock)it->second;
+    flutterSwiftRegistrarCallbacks.erase(it);
+  }
+  // outside the lock, so the handler may itself register or remove handlers
   callbackBlock(registrar);
   _Block_release(callbackBlock);
 }
@@ -105,8 +243,16 @@ static void FlutterDesktopOnPluginRegistrarDestroyedBlockThunk(
 void FlutterDesktopPluginRegistrarSetDestructionHandlerBlock(
     FlutterDesktopPluginRegistrarRef registrar,
     FlutterDesktopOnPluginRegistrarDestroyedBlock callbackBlock) {
-  std::lock_guard<std::mutex> guard(flutterSwiftRegistrarCallbacksMutex);
-  flutterSwiftRegistrarCallbacks[registrar] = _Block_copy(callbackBlock);
+  void *savedCallbackBlock = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(flutterSwiftRegistrarCallbacksMutex);
+    auto &slot = flutterSwiftRegistrarCallbacks[registrar];
+    savedCallbackBlock = slot;
+    slot = _Block_copy(callbackBlock);
+  }
+  if (savedCallbackBlock != nullptr) {
+    _Block_release(savedCallbackBlock);
+  }
   registrar->engine->SetPluginRegistrarDestructionCallback(
       FlutterDesktopOnPluginRegistrarDestroyedBlockThunk);
 }
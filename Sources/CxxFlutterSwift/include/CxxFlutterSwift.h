@@ -47,6 +47,39 @@ FLUTTER_EXPORT bool FlutterDesktopMessengerSendWithReplyBlock(
     const size_t message_size,
     _Nullable FlutterDesktopBinaryReplyBlock replyBlock);
 
+// One contiguous piece of a message sent by
+// FlutterDesktopMessengerSendSegmentsWithReplyBlock.
+typedef struct {
+  const uint8_t *_Nullable data;
+  size_t size;
+} FlutterDesktopMessageSegment;
+
+// As FlutterDesktopMessengerSendWithReplyBlock, for a message given as the
+// concatenation of |segment_count| segments. The segments are gathered into a
+// per-thread buffer, which the engine then copies as it would any message; a
+// single segment is sent as is. The buffer is reused across sends of up to
+// 64 KiB, and freed after larger ones.
+FLUTTER_EXPORT bool FlutterDesktopMessengerSendSegmentsWithReplyBlock(
+    _Nonnull FlutterDesktopMessengerRef messenger,
+    const char *_Nonnull channel,
+    const FlutterDesktopMessageSegment *_Nullable segments,
+    const size_t segment_count,
+    _Nullable FlutterDesktopBinaryReplyBlock replyBlock);
+
+// Creates an anonymous shared memory file of |size| bytes, sealed against
+// resizing, for a data plane shared with the Dart side of the process. Returns
+// the file descriptor, or -1 with errno set.
+FLUTTER_EXPORT int FlutterDesktopSharedMemoryCreate(const char *_Nonnull name,
+                                                    const size_t size);
+
+// Names the calling thread, truncated to the 15 characters Linux allows.
+FLUTTER_EXPORT void FlutterDesktopSetThreadName(const char *_Nonnull name);
+
+// Restricts the calling thread to the |count| CPUs in |cpus|. Returns 0, or an
+// error number.
+FLUTTER_EXPORT int FlutterDesktopSetThreadAffinity(const int *_Nonnull cpus,
+                                                   const size_t count);
+
 typedef __attribute__((__swift_attr__("@Sendable"))) void (
     ^FlutterDesktopMessageCallbackBlock)(_Nonnull FlutterDesktopMessengerRef,
                                          const FlutterDesktopMessage *_Nonnull);
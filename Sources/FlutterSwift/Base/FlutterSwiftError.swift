@@ -30,8 +30,11 @@ public enum FlutterSwiftError: Error, Codable, Equatable {
   case messengerNotAvailable
   case methodNotImplemented
   case notRepresentableAsStandardField
+  case sharedMemoryNotAvailable
   case stringNotDecodable(Data)
   case stringNotEncodable(String)
+  case transferCancelled
+  case transferSizeMismatch
   case unexpectedStandardFieldType(FlutterStandardField)
   case unknownDiscriminant
   case unknownStandardFieldType(UInt8)
@@ -42,8 +42,11 @@ public final class FlutterBasicMessageChannel: _FlutterBinaryMessengerConnection
   public let binaryMessenger: FlutterBinaryMessenger
   public let codec: FlutterMessageCodec
   public let priority: TaskPriority?
+  /// How the messenger runs the handler for each incoming message.
+  public let dispatch: FlutterMessageDispatch
 
   private let _connection: ManagedAtomic<FlutterBinaryMessengerConnection>
+  private let metrics: _FlutterChannelMetricsCache
 
   var connection: FlutterBinaryMessengerConnection {
     get {
@@ -58,13 +61,16 @@ public final class FlutterBasicMessageChannel: _FlutterBinaryMessengerConnection
     name: String,
     binaryMessenger: FlutterBinaryMessenger,
     codec: FlutterMessageCodec = FlutterStandardMessageCodec.shared,
-    priority: TaskPriority? = nil
+    priority: TaskPriority? = nil,
+    dispatch: FlutterMessageDispatch = .concurrent
   ) {
     _connection = ManagedAtomic(0)
     self.name = name
+    metrics = _FlutterChannelMetricsCache(channel: name)
     self.binaryMessenger = binaryMessenger
     self.codec = codec
     self.priority = priority
+    self.dispatch = dispatch
   }
 
   deinit {
@@ -75,20 +81,22 @@ public final class FlutterBasicMessageChannel: _FlutterBinaryMessengerConnection
   }
 
   public func send<Message: Encodable>(message: Message) async throws {
-    try await binaryMessenger.send(on: name, message: codec.encode(message))
+    let message = try metrics.measure(.encode, with: binaryMessenger) { try codec.encode(message) }
+    try await binaryMessenger.send(on: name, message: message)
   }
 
   public func send<Message: Encodable & Sendable, Reply: Decodable & Sendable>(
     message: Message,
     reply type: Reply.Type
   ) async throws -> Reply? {
-    let reply = try await binaryMessenger.send(
+    let message = try metrics.measure(.encode, with: binaryMessenger) { try codec.encode(message) }
+    return try await binaryMessenger.send(
       on: name,
-      message: codec.encode(message),
-      priority: priority
+      message: message,
+      priority: priority,
+      codec: codec,
+      reply: type
     )
-    guard let reply else { return nil }
-    return try codec.decode(reply)
   }
 
   @FlutterPlatformThreadActor
@@ -96,17 +104,19 @@ public final class FlutterBasicMessageChannel: _FlutterBinaryMessengerConnection
     Message: Decodable & Sendable,
     Reply: Encodable & Sendable
   >(_ handler: FlutterMessageHandler<Message, Reply>?) throws {
-    try setMessageHandler(handler) { [codec] unwrappedHandler in
+    try setMessageHandler(handler) { [codec, binaryMessenger, metrics] unwrappedHandler in
       { message in
         let decoded: Message?
 
         if let message {
-          decoded = try codec.decode(message)
+          decoded = try metrics.measure(.decode, with: binaryMessenger) {
+            try codec.decode(message)
+          }
         } else {
           decoded = nil
         }
         let reply = await unwrappedHandler(decoded)
-        return try codec.encode(reply)
+        return try metrics.measure(.encode, with: binaryMessenger) { try codec.encode(reply) }
       }
     }
   }
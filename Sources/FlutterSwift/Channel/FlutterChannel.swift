@@ -43,9 +43,14 @@ public protocol FlutterChannel: AnyObject, Hashable, Equatable {
 
 protocol _FlutterBinaryMessengerConnectionRepresentable: FlutterChannel {
   var connection: FlutterBinaryMessengerConnection { get set }
+  var dispatch: FlutterMessageDispatch { get }
 }
 
-private let kControlChannelName = "dev.flutter/channel-buffers"
+extension _FlutterBinaryMessengerConnectionRepresentable {
+  var dispatch: FlutterMessageDispatch { .concurrent }
+}
+
+let kControlChannelName = "dev.flutter/channel-buffers"
 
 @FlutterPlatformThreadActor
 private func _controlChannelBuffers(
@@ -185,7 +190,8 @@ extension _FlutterBinaryMessengerConnectionRepresentable {
     connection = try binaryMessenger.setMessageHandler(
       on: name,
       handler: block(unwrappedHandler),
-      priority: priority
+      priority: priority,
+      dispatch: dispatch
     )
   }
 }
@@ -0,0 +1,243 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import AsyncAlgorithms
+import Atomics
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/**
+ * A channel for sending large payloads to the Flutter side in bounded chunks.
+ *
+ * Sending a 200 MB asset on a `FlutterBasicMessageChannel` encodes all of it
+ * into one message — a second 200 MB alongside the first — and holds up the
+ * platform thread while the engine copies it across. This channel instead
+ * sends the payload `chunkSize` bytes at a time, with at most `window` chunks
+ * awaiting acknowledgement, so the memory a transfer needs is bounded by
+ * `chunkSize * window` whatever the payload's size, and the platform thread is
+ * free between chunks.
+ *
+ * Every message on the channel is a standard-codec list:
+ *
+ *     [kind, transfer, offset, byteCount, payload]
+ *
+ * - `kind` is `0` for a chunk, `1` for the end of a transfer, `2` for an abort;
+ * - `transfer` identifies the transfer, unique per channel;
+ * - `offset` is where `payload` belongs in the reassembled payload (for the end
+ *   message, the total size sent);
+ * - `byteCount` is the payload's total size, or `null` if it is not known up
+ *   front, for the receiver to preallocate;
+ * - `payload` is a `Uint8List`, or `null` for end and abort messages.
+ *
+ * The Dart side registers a handler for the channel (a `BasicMessageChannel`
+ * with `StandardMessageCodec`) that writes each payload at its offset, and
+ * replies `true` to acknowledge it or `false` to cancel the transfer. Chunks
+ * in flight together may arrive in any order, which is why they carry their
+ * offset. The end message is sent only once every chunk has been
+ * acknowledged, so when it arrives the payload is complete.
+ */
+public final class FlutterChunkedTransferChannel: FlutterChannel, Sendable {
+  /// A page under `FlutterStandardBufferPool`'s default `maximumCapacity`, so
+  /// a chunk's message, header and all, is encoded into a pooled buffer.
+  public static let defaultChunkSize = (1 << 20) - 4096
+  public static let defaultWindow = 4
+
+  public let name: String
+  public let binaryMessenger: FlutterBinaryMessenger
+  public let priority: TaskPriority?
+  /// The most payload bytes sent in one message.
+  public let chunkSize: Int
+  /// The most chunks sent but not yet acknowledged.
+  public let window: Int
+
+  private let _nextTransfer = ManagedAtomic<Int>(0)
+
+  /// The wire format is the standard codec's, whatever the caller prefers.
+  public var codec: FlutterMessageCodec { FlutterStandardMessageCodec.shared }
+
+  public init(
+    name: String,
+    binaryMessenger: FlutterBinaryMessenger,
+    priority: TaskPriority? = nil,
+    chunkSize: Int = defaultChunkSize,
+    window: Int = defaultWindow
+  ) {
+    precondition(chunkSize > 0 && window > 0)
+    self.name = name
+    self.binaryMessenger = binaryMessenger
+    self.priority = priority
+    self.chunkSize = chunkSize
+    self.window = window
+  }
+
+  /// Sends `payload` in chunks.
+  ///
+  /// The chunks are slices of `payload`, sharing its storage. A file sent as
+  /// `Data(contentsOf: url, options: .alwaysMapped)` is therefore read a chunk
+  /// at a time, by the kernel, as the transfer reaches it.
+  public func send(_ payload: Data) async throws {
+    try await send(byteCount: payload.count, chunks: [payload].async)
+  }
+
+  /// Sends the concatenation of `chunks` as one payload of `byteCount` bytes,
+  /// if that is known.
+  ///
+  /// An element larger than `chunkSize` is split into chunks of at most that
+  /// size. Elements are never merged, however small: each is sent as at least
+  /// one chunk of its own, so a sequence yielding many small elements is best
+  /// sized to `chunkSize` at its source.
+  ///
+  /// `chunks` is consumed only as fast as the window allows, so a sequence that
+  /// produces its elements lazily — reading a file, say — is never more than
+  /// the window ahead of the receiver.
+  ///
+  /// If `chunks` yields more or fewer than `byteCount` bytes, the transfer is
+  /// aborted and `FlutterSwiftError.transferSizeMismatch` thrown: the excess
+  /// is never sent, and a short payload is never ended as though complete.
+  public func send<Chunks: AsyncSequence>(
+    byteCount: Int? = nil,
+    chunks: Chunks
+  ) async throws where Chunks.Element == Data {
+    let transfer = _nextTransfer.loadThenWrappingIncrement(ordering: .relaxed)
+    do {
+      let sent = try await withThrowingTaskGroup(of: Void.self) { group in
+        var offset = 0
+        var inFlight = 0
+
+        for try await data in chunks {
+          for start in stride(from: data.startIndex, to: data.endIndex, by: chunkSize) {
+            if inFlight == window {
+              _ = try await group.next()
+              inFlight -= 1
+            }
+            let end = min(start + chunkSize, data.endIndex)
+            if let byteCount, offset + end - start > byteCount {
+              throw FlutterSwiftError.transferSizeMismatch
+            }
+            let chunk = FlutterTransferMessage(
+              kind: .chunk,
+              transfer: transfer,
+              offset: offset,
+              byteCount: byteCount,
+              payload: data[start..<end]
+            )
+            group.addTask { try await self.sendAcknowledged(chunk) }
+            inFlight += 1
+            offset += end - start
+          }
+        }
+        if let byteCount, offset != byteCount {
+          throw FlutterSwiftError.transferSizeMismatch
+        }
+        try await group.waitForAll()
+        return offset
+      }
+      try await sendAcknowledged(FlutterTransferMessage(
+        kind: .end,
+        transfer: transfer,
+        offset: sent,
+        byteCount: byteCount
+      ))
+    } catch {
+      // tell the receiver to discard what it has; it may be what failed
+      try? await binaryMessenger.send(
+        on: name,
+        message: codec.encode(FlutterTransferMessage(
+          kind: .abort,
+          transfer: transfer,
+          offset: 0,
+          byteCount: byteCount
+        ))
+      )
+      throw error
+    }
+  }
+
+  private func sendAcknowledged(_ message: FlutterTransferMessage) async throws {
+    let acknowledged = try await binaryMessenger.send(
+      on: name,
+      message: codec.encode(message),
+      priority: priority,
+      codec: codec,
+      reply: Bool.self
+    )
+    switch acknowledged {
+    case true:
+      break
+    case false:
+      throw FlutterSwiftError.transferCancelled
+    case nil:
+      // no handler on the Dart side
+      throw FlutterSwiftError.messageSendFailure
+    }
+  }
+}
+
+/// One message of a chunked transfer; see `FlutterChunkedTransferChannel`.
+struct FlutterTransferMessage: FlutterStandardEncodable, Sendable {
+  enum Kind: Int32 {
+    case chunk = 0
+    case end = 1
+    case abort = 2
+  }
+
+  let kind: Kind
+  let transfer: Int64
+  let offset: Int64
+  let byteCount: Int64?
+  let payload: Data?
+
+  init(kind: Kind, transfer: Int, offset: Int, byteCount: Int?, payload: Data? = nil) {
+    self.kind = kind
+    self.transfer = Int64(transfer)
+    self.offset = Int64(offset)
+    self.byteCount = byteCount.map { Int64($0) }
+    self.payload = payload
+  }
+
+  func write(to writer: inout FlutterStandardWriter) throws(FlutterSwiftError) {
+    try writer.writeListHeader(count: 5)
+    writer.write(kind.rawValue)
+    writer.write(transfer)
+    writer.write(offset)
+    if let byteCount {
+      writer.write(byteCount)
+    } else {
+      writer.writeNil()
+    }
+    if let payload {
+      try writer.write(payload)
+    } else {
+      writer.writeNil()
+    }
+  }
+
+  /// The same list, for encoders other than the standard one; copies the
+  /// payload, as only they need it to.
+  func encode(to encoder: any Encoder) throws {
+    var container = encoder.singleValueContainer()
+    try container.encode(AnyFlutterStandardCodable.list([
+      .int32(kind.rawValue),
+      .int64(transfer),
+      .int64(offset),
+      byteCount.map { .int64($0) } ?? .nil,
+      payload.map { .uint8Data([UInt8]($0)) } ?? .nil,
+    ]))
+  }
+}
@@ -30,6 +30,29 @@ import Synchronization
  */
 public typealias FlutterEventStream<Event: Codable & Sendable> = AnyAsyncSequence<Event?>
 
+/**
+ * How a `FlutterEventChannel` delivers events when its stream produces them
+ * faster than they can be sent.
+ */
+public enum FlutterEventDeliveryPolicy: Sendable {
+  /// Every event is sent, in order, as the stream produces it; a slow send holds
+  /// up the stream. This is the default.
+  case unbounded
+  /// Events the channel has not yet sent are buffered, up to `capacity` of
+  /// them (at least one); past that the oldest are dropped. Whatever is
+  /// buffered is sent in one turn of the platform thread.
+  case bufferingNewest(Int)
+  /// Events are collected for `interval` from the first of them and sent as a
+  /// single envelope holding a list, so the Dart side receives `List` events.
+  /// At most `capacity` events (at least one, 1024 by default) are held per
+  /// window; past that the oldest are dropped.
+  case batched(interval: Duration, capacity: Int = 1024)
+
+  /// Only the most recent event is kept: a slow subscriber sees the current
+  /// value, never a backlog.
+  public static var latest: Self { .bufferingNewest(1) }
+}
+
 /**
  * A channel for communicating with the Flutter side using event streams.
  */
@@ -40,6 +63,7 @@ public final class FlutterEventChannel: _FlutterBinaryMessengerConnectionReprese
   public let binaryMessenger: FlutterBinaryMessenger
   public let codec: FlutterMessageCodec
   public let priority: TaskPriority?
+  public let deliveryPolicy: FlutterEventDeliveryPolicy
 
   private typealias EventStreamTask = Task<(), Never>
 
@@ -57,6 +81,7 @@ public final class FlutterEventChannel: _FlutterBinaryMessengerConnectionReprese
   private let _channelBufferSize = ManagedAtomic<Int>(1)
   private let _channelBufferOverflowAllowed = ManagedAtomic<Bool>(false)
   private let _nextGeneration = ManagedAtomic<UInt64>(0)
+  private let metrics: _FlutterChannelMetricsCache
   private let tasks: Mutex<[String: EventStreamEntry]>
 
   var connection: FlutterBinaryMessengerConnection {
@@ -100,18 +125,22 @@ public final class FlutterEventChannel: _FlutterBinaryMessengerConnectionReprese
    * @param binaryMessenger The binary messenger.
    * @param codec The method codec.
    * @param taskQueue The FlutterTaskQueue that executes the handler
+   * @param deliveryPolicy How events are delivered when the stream outpaces the channel.
    */
   public init(
     name: String,
     binaryMessenger: FlutterBinaryMessenger,
     codec: FlutterMessageCodec = FlutterStandardMessageCodec.shared,
-    priority: TaskPriority? = nil
+    priority: TaskPriority? = nil,
+    deliveryPolicy: FlutterEventDeliveryPolicy = .unbounded
   ) {
     tasks = Mutex([:])
+    metrics = _FlutterChannelMetricsCache(channel: name)
     self.name = name
     self.binaryMessenger = binaryMessenger
     self.codec = codec
     self.priority = priority
+    self.deliveryPolicy = deliveryPolicy
   }
 
   deinit {
@@ -178,27 +207,108 @@ public final class FlutterEventChannel: _FlutterBinaryMessengerConnectionReprese
     try binaryMessenger.send(on: name, message: message)
   }
 
-  private func _run<Event: Codable & Sendable>(
-    for stream: FlutterEventStream<Event>,
-    name: String
+  /// As `_send(on:message:)`, for several messages in one hop. The first failed
+  /// send is rethrown, once the rest of the batch has been attempted.
+  @FlutterPlatformThreadActor
+  private func _send(on name: String, messages: [Data]) throws {
+    guard connection > 0, !messages.isEmpty else { return }
+    for result in binaryMessenger.send(batch: messages.map { (name, $0) }) {
+      try result.get()
+    }
+  }
+
+  private func _encode<Value: Encodable>(
+    _ value: Value,
+    with metrics: _FlutterChannelMetricsCache
+  ) throws -> Data {
+    try metrics.measure(.encode, with: binaryMessenger) { try codec.encode(value) }
+  }
+
+  /// Sends the events the stream produces, under the channel's delivery policy,
+  /// until it finishes or the task is cancelled.
+  private func _deliver<Event: Codable & Sendable>(
+    _ stream: FlutterEventStream<Event>,
+    to name: String,
+    metrics: _FlutterChannelMetricsCache
   ) async throws {
-    do {
+    let capacity: Int
+    let interval: Duration?
+
+    switch deliveryPolicy {
+    case .unbounded:
       for try await event in stream {
         let envelope = FlutterEnvelope.success(event)
-        try await _send(on: name, message: codec.encode(envelope))
+        try await _send(on: name, message: _encode(envelope, with: metrics))
         try Task.checkCancellation()
       }
+      return
+    case let .bufferingNewest(bufferingNewest):
+      capacity = bufferingNewest
+      interval = nil
+    case let .batched(batchInterval, batchCapacity):
+      capacity = batchCapacity
+      interval = batchInterval
+    }
+
+    // The stream is drained on its own task, so a slow send applies the policy
+    // to what accumulates rather than holding up the producer.
+    let buffer = _FlutterEventBuffer<Event>(capacity: capacity)
+    let producer = Task(priority: priority) {
+      do {
+        for try await event in stream {
+          buffer.append(event)
+        }
+        buffer.finish()
+      } catch {
+        buffer.finish(throwing: error)
+      }
+    }
+    defer { producer.cancel() }
+
+    while true {
+      await buffer.wait()
+      if let interval, buffer.hasEvents {
+        // the window opens with its first event; a bare completion need not wait
+        try await Task.sleep(for: interval)
+      }
+      try Task.checkCancellation()
+
+      let (events, completion) = buffer.take()
+      if !events.isEmpty {
+        if interval != nil {
+          let envelope = FlutterEnvelope<[Event?]>.success(events)
+          try await _send(on: name, message: _encode(envelope, with: metrics))
+        } else {
+          let messages = try events.map { try _encode(FlutterEnvelope.success($0), with: metrics) }
+          try await _send(on: name, messages: messages)
+        }
+      }
+      if let completion {
+        try completion.get()
+        return
+      }
+    }
+  }
+
+  private func _run<Event: Codable & Sendable>(
+    for stream: FlutterEventStream<Event>,
+    name: String
+  ) async throws {
+    // each subscription's events go to a name of their own
+    let metrics = _FlutterChannelMetricsCache(channel: name)
+    do {
+      try await _deliver(stream, to: name, metrics: metrics)
       try await _send(on: name, message: nil)
     } catch let error as FlutterError {
       let envelope = FlutterEnvelope<Event>.failure(error)
-      try await _send(on: name, message: codec.encode(envelope))
+      try await _send(on: name, message: _encode(envelope, with: metrics))
     } catch is CancellationError {
       // No end-of-stream from here: cancellation means either the subscriber
       // asked to stop, or the channel is being retired — and the retirement
       // paths close the stream themselves, while the handler is still live.
     } catch {
       let envelope = FlutterEnvelope<Event>.failure(error.flutterError)
-      try await _send(on: name, message: codec.encode(envelope))
+      try await _send(on: name, message: _encode(envelope, with: metrics))
     }
   }
 
@@ -336,14 +446,19 @@ public final class FlutterEventChannel: _FlutterBinaryMessengerConnectionReprese
           throw FlutterSwiftError.methodNotImplemented
         }
 
-        let call: FlutterMethodCall<Arguments> = try self.codec.decode(message)
+        let call: FlutterMethodCall<Arguments> = try self.metrics.measure(
+          .decode,
+          with: self.binaryMessenger
+        ) {
+          try self.codec.decode(message)
+        }
         let envelope: FlutterEnvelope<Arguments>? = try await self.onMethod(
           call: call,
           onListen: unwrappedHandler,
           onCancel: onCancel
         )
         guard let envelope else { return nil }
-        return try self.codec.encode(envelope)
+        return try self._encode(envelope, with: self.metrics)
       }
     }
   }
@@ -369,3 +484,90 @@ public final class FlutterEventChannel: _FlutterBinaryMessengerConnectionReprese
     channelBufferOverflowAllowed = allowed
   }
 }
+
+/// The events a `FlutterEventChannel` has received from its stream but not yet
+/// sent, for the buffering delivery policies.
+///
+/// Past `capacity`, the oldest events are dropped. There is a single consumer,
+/// which `wait()`s for events or completion and then `take()`s all of them.
+private final class _FlutterEventBuffer<Event: Sendable>: Sendable {
+  private struct State {
+    // a ring once full: `start` is then the oldest, and the next to overwrite
+    var events = [Event?]()
+    var start = 0
+    var completion: Result<(), Error>?
+    var isCancelled = false
+    var waiter: CheckedContinuation<(), Never>?
+
+    var isReady: Bool {
+      !events.isEmpty || completion != nil || isCancelled
+    }
+  }
+
+  private let capacity: Int
+  private let state = Mutex(State())
+
+  init(capacity: Int) {
+    self.capacity = max(capacity, 1)
+  }
+
+  var hasEvents: Bool {
+    state.withLock { !$0.events.isEmpty }
+  }
+
+  func append(_ event: Event?) {
+    let waiter = state.withLock { state in
+      if state.events.count == capacity {
+        // drop the oldest in place
+        state.events[state.start] = event
+        state.start = (state.start + 1) % capacity
+      } else {
+        state.events.append(event)
+      }
+      return state.waiter.take()
+    }
+    waiter?.resume()
+  }
+
+  func finish(throwing error: Error? = nil) {
+    let waiter = state.withLock { state in
+      state.completion = error.map { .failure($0) } ?? .success(())
+      return state.waiter.take()
+    }
+    waiter?.resume()
+  }
+
+  /// Waits until there is something to take, or the calling task is cancelled.
+  func wait() async {
+    await withTaskCancellationHandler {
+      await withCheckedContinuation { continuation in
+        let isReady = state.withLock { state in
+          guard !state.isReady else { return true }
+          state.waiter = continuation
+          return false
+        }
+        if isReady {
+          continuation.resume()
+        }
+      }
+    } onCancel: {
+      let waiter = state.withLock { state in
+        state.isCancelled = true
+        return state.waiter.take()
+      }
+      waiter?.resume()
+    }
+  }
+
+  /// Removes and returns the buffered events, and the stream's completion if it
+  /// has finished.
+  func take() -> (events: [Event?], completion: Result<(), Error>?) {
+    state.withLock { state in
+      let events = state.start == 0 ? state.events :
+        Array(state.events[state.start...] + state.events[..<state.start])
+      state.events.removeAll(keepingCapacity: true)
+      state.start = 0
+      return (events, state.completion)
+    }
+  }
+}
@@ -0,0 +1,298 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Atomics
+import Dispatch
+import Synchronization
+#if canImport(Darwin)
+import Darwin
+#elseif canImport(Glibc)
+import Glibc
+#elseif canImport(Android)
+import Android
+#endif
+#if os(Linux) && canImport(Glibc)
+@_implementationOnly
+import CxxFlutterSwift
+#endif
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/**
+ * A fixed set of threads for running CPU-heavy channel handlers, away from
+ * the cooperative pool that every other task shares.
+ *
+ * Pass one to `FlutterMethodChannel(name:binaryMessenger:handlerExecutor:)` and
+ * the channel's handlers run on its threads — including whatever they await
+ * that has no executor of its own — so an image transform or a compression
+ * pass occupies these threads, not the ones latency-sensitive channels need.
+ * Several channels may share a pool.
+ *
+ * Each thread has its own queue. Work is spread over the queues round robin,
+ * or kept on the current thread's queue when it is enqueued from one of the
+ * pool's own threads, and a thread that runs out of work steals from the
+ * others before it sleeps, so long jobs do not strand short ones behind them.
+ */
+public final class FlutterHandlerThreadPool: TaskExecutor, @unchecked Sendable {
+  /// Where the pool's threads may run.
+  public enum Affinity: Hashable, Sendable {
+    /// Wherever the scheduler puts them.
+    case none
+    /// Each thread on one CPU: the first thread on the first of `cpus`, the
+    /// second on the second, and so on, wrapping around.
+    case pinned(cpus: [Int])
+    /// Every thread on any of `cpus`, such as the performance cores.
+    case restricted(cpus: [Int])
+
+    /// Affinity is set on Linux. Elsewhere, the threads run unconstrained.
+    public static var isSupported: Bool {
+      #if os(Linux) && canImport(Glibc)
+      true
+      #else
+      false
+      #endif
+    }
+  }
+
+  public let threadCount: Int
+  public let affinity: Affinity
+
+  private let workers: [_FlutterHandlerWorker]
+  private let nextWorker = ManagedAtomic<Int>(0)
+  private let idleCount = ManagedAtomic<Int>(0)
+  private let isShutDown = ManagedAtomic<Bool>(false)
+  private let wakeUp = DispatchSemaphore(value: 0)
+
+  /// Starts `threadCount` threads, one per active CPU by default.
+  public init(
+    threadCount: Int = ProcessInfo.processInfo.activeProcessorCount,
+    affinity: Affinity = .none
+  ) {
+    precondition(threadCount > 0)
+    self.threadCount = threadCount
+    self.affinity = affinity
+    workers = (0..<threadCount).map { _FlutterHandlerWorker(index: $0) }
+    for worker in workers {
+      worker.start(in: self)
+    }
+  }
+
+  /// Stops the threads once they have run what is already queued. A task that
+  /// still prefers the pool, such as one awaiting across the shutdown, carries
+  /// on on the global concurrent executor.
+  public func shutdown() {
+    guard !isShutDown.exchange(true, ordering: .sequentiallyConsistent) else { return }
+    for _ in workers {
+      wakeUp.signal()
+    }
+  }
+
+  /// Whether the caller is running on one of the pool's threads.
+  public var isCurrent: Bool {
+    _FlutterHandlerWorker.current?.pool === self
+  }
+
+  /// Which of the pool's threads the caller is running on, if any.
+  var currentThreadIndex: Int? {
+    guard let current = _FlutterHandlerWorker.current, current.pool === self else { return nil }
+    return current.index
+  }
+
+  public func enqueue(_ job: consuming ExecutorJob) {
+    guard !isShutDown.load(ordering: .sequentiallyConsistent) else {
+      globalConcurrentExecutor.enqueue(job)
+      return
+    }
+    let job = UnownedJob(job)
+    let worker: _FlutterHandlerWorker
+    if let current = _FlutterHandlerWorker.current, current.pool === self {
+      worker = current
+    } else {
+      worker = workers[nextWorker.loadThenWrappingIncrement(ordering: .relaxed) % workers.count]
+    }
+    worker.jobs.withLock { $0.append(job) }
+    // pairs with the idle count's increment in run(_:): either that worker's
+    // rescan finds this job, or this finds the worker idle and wakes it
+    if idleCount.load(ordering: .sequentiallyConsistent) > 0 {
+      wakeUp.signal()
+    }
+  }
+
+  // MARK: - workers
+
+  fileprivate func cpus(for worker: _FlutterHandlerWorker) -> [Int] {
+    switch affinity {
+    case .none:
+      []
+    case let .pinned(cpus):
+      cpus.isEmpty ? [] : [cpus[worker.index % cpus.count]]
+    case let .restricted(cpus):
+      cpus
+    }
+  }
+
+  /// The next job for `worker`: its own oldest, or else another's.
+  private func nextJob(for worker: _FlutterHandlerWorker) -> UnownedJob? {
+    if let job = worker.jobs.withLock({ $0.popFirst() }) {
+      return job
+    }
+    for offset in 1..<workers.count {
+      let victim = workers[(worker.index + offset) % workers.count]
+      if let job = victim.jobs.withLock({ $0.popFirst() }) {
+        return job
+      }
+    }
+    return nil
+  }
+
+  fileprivate func run(_ worker: _FlutterHandlerWorker) {
+    let executor = asUnownedTaskExecutor()
+    while true {
+      if let job = nextJob(for: worker) {
+        job.runSynchronously(on: executor)
+        continue
+      }
+      idleCount.wrappingIncrement(ordering: .sequentiallyConsistent)
+      if let job = nextJob(for: worker) {
+        idleCount.wrappingDecrement(ordering: .sequentiallyConsistent)
+        job.runSynchronously(on: executor)
+        continue
+      }
+      if isShutDown.load(ordering: .sequentiallyConsistent) {
+        idleCount.wrappingDecrement(ordering: .sequentiallyConsistent)
+        // a job enqueued just before shutdown() may have landed after the rescan
+        if let job = nextJob(for: worker) {
+          job.runSynchronously(on: executor)
+          continue
+        }
+        return
+      }
+      wakeUp.wait()
+      idleCount.wrappingDecrement(ordering: .sequentiallyConsistent)
+    }
+  }
+}
+
+/// One of a `FlutterHandlerThreadPool`'s threads, and its queue.
+private final class _FlutterHandlerWorker: @unchecked Sendable {
+  struct Jobs {
+    private var jobs = [UnownedJob]()
+    private var head = 0
+
+    mutating func append(_ job: UnownedJob) {
+      jobs.append(job)
+    }
+
+    mutating func popFirst() -> UnownedJob? {
+      guard head < jobs.count else { return nil }
+      defer {
+        head += 1
+        if head == jobs.count {
+          jobs.removeAll(keepingCapacity: true)
+          head = 0
+        }
+      }
+      return jobs[head]
+    }
+  }
+
+  let index: Int
+  let jobs = Mutex(Jobs())
+  // set before the thread starts; the thread holds the pool until it exits
+  private(set) unowned(unsafe) var pool: FlutterHandlerThreadPool?
+
+  init(index: Int) {
+    self.index = index
+  }
+
+  private static let currentKey: pthread_key_t = {
+    var key = pthread_key_t()
+    pthread_key_create(&key, nil)
+    return key
+  }()
+
+  /// The worker whose thread this is, if any.
+  static var current: _FlutterHandlerWorker? {
+    pthread_getspecific(currentKey).map {
+      Unmanaged<_FlutterHandlerWorker>.fromOpaque($0).takeUnretainedValue()
+    }
+  }
+
+  func start(in pool: FlutterHandlerThreadPool) {
+    self.pool = pool
+    #if canImport(Darwin)
+    var thread: pthread_t?
+    #else
+    var thread = pthread_t()
+    #endif
+    // the thread holds the pool, which holds its workers, until shutdown()
+    _ = Unmanaged.passRetained(pool)
+    let result = pthread_create(
+      &thread,
+      nil,
+      _flutterHandlerWorkerMain,
+      Unmanaged.passRetained(self).toOpaque()
+    )
+    precondition(result == 0, "pthread_create: \(result)")
+    #if canImport(Darwin)
+    pthread_detach(thread!)
+    #else
+    pthread_detach(thread)
+    #endif
+  }
+
+  fileprivate func main() {
+    let pool = pool!
+    let name = "FlutterPool-\(index)"
+    #if canImport(Darwin)
+    pthread_setname_np(name)
+    #elseif os(Linux) && canImport(Glibc)
+    FlutterDesktopSetThreadName(name)
+    #else
+    pthread_setname_np(pthread_self(), name)
+    #endif
+    pthread_setspecific(Self.currentKey, Unmanaged.passUnretained(self).toOpaque())
+
+    #if os(Linux) && canImport(Glibc)
+    let cpus = pool.cpus(for: self).map { Int32($0) }
+    if !cpus.isEmpty, FlutterDesktopSetThreadAffinity(cpus, cpus.count) != 0 {
+      debugPrint("Warning: could not set the affinity of \(name) to CPUs \(cpus)")
+    }
+    #endif
+
+    pool.run(self)
+    Unmanaged.passUnretained(pool).release()
+  }
+}
+
+#if canImport(Darwin)
+private func _flutterHandlerWorkerMain(_ context: UnsafeMutableRawPointer)
+  -> UnsafeMutableRawPointer?
+{
+  Unmanaged<_FlutterHandlerWorker>.fromOpaque(context).takeRetainedValue().main()
+  return nil
+}
+#else
+private func _flutterHandlerWorkerMain(_ context: UnsafeMutableRawPointer?)
+  -> UnsafeMutableRawPointer?
+{
+  Unmanaged<_FlutterHandlerWorker>.fromOpaque(context!).takeRetainedValue().main()
+  return nil
+}
+#endif
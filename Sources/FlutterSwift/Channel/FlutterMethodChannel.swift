@@ -70,6 +70,13 @@ extension FlutterMethodCall: Hashable where Arguments: Codable & Hashable {
   }
 }
 
+/// Carries a decoded reply out of the messenger's reply callback. `Result` need
+/// not be `Sendable`, but the envelope is handed over exactly once, from the
+/// callback to the task awaiting it, and never touched by the callback again.
+private struct _ReplyEnvelope<Result: Codable>: @unchecked Sendable {
+  let envelope: FlutterEnvelope<Result>
+}
+
 /**
  * A channel for communicating with the Flutter side using invocation of
  * asynchronous methods.
@@ -81,8 +88,14 @@ public final class FlutterMethodChannel: _FlutterBinaryMessengerConnectionRepres
   public let binaryMessenger: FlutterBinaryMessenger
   public let codec: FlutterMessageCodec
   public let priority: TaskPriority?
+  /// How the messenger runs the handler for each incoming message.
+  public let dispatch: FlutterMessageDispatch
+  /// Where incoming calls are decoded, handled and replied to, such as a
+  /// `FlutterHandlerThreadPool`, or `nil` for the default executor.
+  public let handlerExecutor: (any TaskExecutor)?
 
   private let _connection: ManagedAtomic<FlutterBinaryMessengerConnection>
+  private let metrics: _FlutterChannelMetricsCache
 
   var connection: FlutterBinaryMessengerConnection {
     get {
@@ -97,13 +110,18 @@ public final class FlutterMethodChannel: _FlutterBinaryMessengerConnectionRepres
     name: String,
     binaryMessenger: FlutterBinaryMessenger,
     codec: FlutterMessageCodec = FlutterStandardMessageCodec.shared,
-    priority: TaskPriority? = nil
+    priority: TaskPriority? = nil,
+    dispatch: FlutterMessageDispatch = .concurrent,
+    handlerExecutor: (any TaskExecutor)? = nil
   ) {
     _connection = ManagedAtomic(0)
     self.name = name
+    metrics = _FlutterChannelMetricsCache(channel: name)
     self.binaryMessenger = binaryMessenger
     self.codec = codec
     self.priority = priority
+    self.dispatch = dispatch
+    self.handlerExecutor = handlerExecutor
   }
 
   deinit {
@@ -118,7 +136,10 @@ public final class FlutterMethodChannel: _FlutterBinaryMessengerConnectionRepres
     arguments: Arguments?
   ) async throws {
     let methodCall = FlutterMethodCall<Arguments>(method: method, arguments: arguments)
-    try await binaryMessenger.send(on: name, message: codec.encode(methodCall))
+    let message = try metrics.measure(.encode, with: binaryMessenger) {
+      try codec.encode(methodCall)
+    }
+    try await binaryMessenger.send(on: name, message: message)
   }
 
   public func invoke<Arguments: Codable & Sendable, Result: Codable>(
@@ -129,13 +150,22 @@ public final class FlutterMethodChannel: _FlutterBinaryMessengerConnectionRepres
       method: method,
       arguments: arguments
     )
+    let message = try metrics.measure(.encode, with: binaryMessenger) {
+      try codec.encode(methodCall)
+    }
+    // decoded in place, inside the reply callback, rather than from a copy
     let reply = try await binaryMessenger.send(
       on: name,
-      message: codec.encode(methodCall),
+      message: message,
       priority: priority
-    )
-    guard let reply else { throw FlutterSwiftError.methodNotImplemented }
-    let envelope: FlutterEnvelope<Result> = try codec.decode(reply)
+    ) { [codec, binaryMessenger, metrics] reply in
+      try reply.map { reply in
+        try metrics.measure(.decode, with: binaryMessenger) {
+          try _ReplyEnvelope<Result>(envelope: codec.decode(borrowing: reply))
+        }
+      }
+    }
+    guard let envelope = reply?.envelope else { throw FlutterSwiftError.methodNotImplemented }
     switch envelope {
     case let .success(value):
       return value
@@ -149,22 +179,30 @@ public final class FlutterMethodChannel: _FlutterBinaryMessengerConnectionRepres
     Arguments: Codable & Sendable,
     Result: Codable
   >(_ handler: FlutterMethodCallHandler<Arguments, Result>?) throws {
-    try setMessageHandler(handler) { [codec] unwrappedHandler in
+    try setMessageHandler(handler) {
+      [codec, binaryMessenger, metrics, handlerExecutor] unwrappedHandler in
       { message in
         guard let message else {
           throw FlutterSwiftError.methodNotImplemented
         }
 
-        let call: FlutterMethodCall<Arguments> = try codec.decode(message)
-        let envelope: FlutterEnvelope<Result>
-        do {
-          envelope = try await .success(unwrappedHandler(call))
-        } catch let error as FlutterError {
-          envelope = .failure(error)
-        } catch {
-          envelope = .failure(error.flutterError)
+        return try await withTaskExecutorPreference(handlerExecutor) {
+          let call: FlutterMethodCall<Arguments> = try metrics.measure(
+            .decode,
+            with: binaryMessenger
+          ) {
+            try codec.decode(message)
+          }
+          let envelope: FlutterEnvelope<Result>
+          do {
+            envelope = try await .success(unwrappedHandler(call))
+          } catch let error as FlutterError {
+            envelope = .failure(error)
+          } catch {
+            envelope = .failure(error.flutterError)
+          }
+          return try metrics.measure(.encode, with: binaryMessenger) { try codec.encode(envelope) }
         }
-        return try codec.encode(envelope)
       }
     }
   }
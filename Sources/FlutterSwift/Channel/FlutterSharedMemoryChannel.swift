@@ -0,0 +1,256 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#if os(Linux) && canImport(Glibc)
+@_implementationOnly
+import CxxFlutterSwift
+import Glibc
+import Synchronization
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/**
+ * A channel that sends bulk payloads to the Flutter side through shared
+ * memory, with a method channel of the same name carrying only descriptors.
+ *
+ * However a payload is sent as a platform message, the engine copies it into
+ * its own allocation, and Dart copies it again into a `Uint8List`. On Linux
+ * the engine and the Dart VM share our address space, so this channel instead
+ * writes payloads into a ring buffer backed by a `memfd`, which the Dart side
+ * maps once with `dart:ffi`; each payload then costs a single write into the
+ * ring, and a descriptor message of three integers.
+ *
+ * The method channel is the control plane:
+ *
+ * - Dart invokes `attach`, with no arguments, and is answered with the
+ *   `Int64List` `[fd, capacity]`: a file descriptor it can `mmap` `capacity`
+ *   bytes of, `MAP_SHARED` and `PROT_READ`;
+ * - Swift invokes `data` with the `Int64List` `[sequence, offset, length]`
+ *   for each payload: the payload is the `length` bytes at `offset` in the
+ *   mapping, and `sequence` counts payloads from zero. A payload is never
+ *   split across the end of the ring.
+ *
+ * The bytes of a payload stay valid until Dart replies to its `data` call,
+ * with any value; Dart must copy out whatever it wants to keep before then.
+ * The ring reclaims space in sequence order, so a payload whose reply is
+ * outstanding holds back the space of those after it, and `send` waits for
+ * space when the ring is full. Waiting sends are given space in the order
+ * they arrived, so a large payload is not overtaken indefinitely by smaller
+ * ones that happen to fit.
+ */
+public final class FlutterSharedMemoryChannel: FlutterChannel, Sendable {
+  public static let defaultCapacity = 16 << 20
+
+  public let name: String
+  public let binaryMessenger: FlutterBinaryMessenger
+  public let priority: TaskPriority?
+
+  private let methodChannel: FlutterMethodChannel
+  private let region: FlutterSharedMemoryRegion
+  private let ring: Mutex<FlutterSharedMemoryRing>
+
+  /// The control plane's codec; payloads are raw bytes.
+  public var codec: FlutterMessageCodec { methodChannel.codec }
+
+  /// The size of the ring, and so the largest payload it can carry.
+  public var capacity: Int { region.bytes.count }
+
+  /// Creates the ring and registers the `attach` handler.
+  @FlutterPlatformThreadActor
+  public init(
+    name: String,
+    binaryMessenger: FlutterBinaryMessenger,
+    capacity: Int = defaultCapacity,
+    priority: TaskPriority? = nil
+  ) throws {
+    precondition(capacity > 0)
+    self.name = name
+    self.binaryMessenger = binaryMessenger
+    self.priority = priority
+    region = try FlutterSharedMemoryRegion(name: name, capacity: capacity)
+    ring = Mutex(FlutterSharedMemoryRing(capacity: capacity))
+    methodChannel = FlutterMethodChannel(
+      name: name,
+      binaryMessenger: binaryMessenger,
+      priority: priority
+    )
+    // the region, not self, so that the handler does not keep the channel alive
+    try methodChannel.setMethodCallHandler {
+      [region] (call: FlutterMethodCall<FlutterNull>) -> [Int64]? in
+      guard call.method == "attach" else { throw FlutterSwiftError.methodNotImplemented }
+      return [Int64(region.fd), Int64(region.bytes.count)]
+    }
+  }
+
+  /// Sends a copy of `payload` through the ring.
+  public func send(_ payload: Data) async throws {
+    try await send(byteCount: payload.count) { bytes in
+      _ = payload.copyBytes(to: bytes)
+    }
+  }
+
+  /// Sends a payload of `byteCount` bytes, which `body` writes directly into
+  /// the ring; it need not be copied from anywhere else first.
+  ///
+  /// Throws `FlutterSwiftError.variableSizedTypeTooBig` if `byteCount` exceeds
+  /// `capacity`.
+  public func send(
+    byteCount: Int,
+    _ body: (UnsafeMutableRawBufferPointer) throws -> ()
+  ) async throws {
+    guard byteCount <= capacity else { throw FlutterSwiftError.variableSizedTypeTooBig }
+
+    let reservation = await reserve(byteCount)
+    defer { release(reservation.sequence) }
+
+    let offset = reservation.offset
+    try body(UnsafeMutableRawBufferPointer(rebasing: region.bytes[offset..<offset + byteCount]))
+    let _: AnyFlutterStandardCodable? = try await methodChannel.invoke(
+      method: "data",
+      arguments: [reservation.sequence, Int64(offset), Int64(byteCount)]
+    )
+  }
+
+  private func reserve(_ byteCount: Int) async -> FlutterSharedMemoryRing.Reservation {
+    if let reservation = ring.withLock({ $0.reserveUnlessWaiting(byteCount) }) {
+      return reservation
+    }
+    // checked and enqueued under the one lock, so a release cannot slip in
+    // between and leave us waiting on space that is already free
+    return await withCheckedContinuation { continuation in
+      let reservation = ring.withLock { ring in
+        if let reservation = ring.reserveUnlessWaiting(byteCount) {
+          return reservation
+        }
+        ring.waiters.append((byteCount, continuation))
+        return nil
+      }
+      if let reservation { continuation.resume(returning: reservation) }
+    }
+  }
+
+  private func release(_ sequence: Int64) {
+    for (waiter, reservation) in ring.withLock({ $0.release(sequence) }) {
+      waiter.resume(returning: reservation)
+    }
+  }
+}
+
+/// The `memfd` behind a `FlutterSharedMemoryChannel`, mapped for writing.
+private final class FlutterSharedMemoryRegion: @unchecked Sendable {
+  let fd: CInt
+  let bytes: UnsafeMutableRawBufferPointer
+
+  init(name: String, capacity: Int) throws {
+    fd = FlutterDesktopSharedMemoryCreate(name, capacity)
+    guard fd >= 0 else { throw FlutterSwiftError.sharedMemoryNotAvailable }
+    let address = mmap(nil, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+    guard let address, address != UnsafeMutableRawPointer(bitPattern: -1) else {
+      close(fd)
+      throw FlutterSwiftError.sharedMemoryNotAvailable
+    }
+    bytes = UnsafeMutableRawBufferPointer(start: address, count: capacity)
+  }
+
+  deinit {
+    munmap(bytes.baseAddress, bytes.count)
+    close(fd)
+  }
+}
+
+/// Allocation state for the ring: a payload occupies `[head, head + count)`
+/// in a monotonic byte count, of which the ring holds the last `capacity`.
+struct FlutterSharedMemoryRing {
+  struct Reservation {
+    let sequence: Int64
+    let offset: Int
+  }
+
+  let capacity: Int
+  /// Bytes reserved since creation, including any skipped at the end of the
+  /// ring so that a payload is contiguous.
+  private var head = 0
+  /// Bytes reclaimed since creation.
+  private var tail = 0
+  private var nextSequence: Int64 = 0
+  /// Outstanding payloads, in sequence order, with where each one ends.
+  private var outstanding = [(sequence: Int64, end: Int, isReleased: Bool)]()
+  /// Sends awaiting space, in arrival order, and the bytes each needs.
+  var waiters = [(count: Int, continuation: CheckedContinuation<Reservation, Never>)]()
+
+  init(capacity: Int) {
+    self.capacity = capacity
+  }
+
+  private func placement(of count: Int) -> (offset: Int, skipped: Int)? {
+    let position = head % capacity
+    let skipped = position + count > capacity ? capacity - position : 0
+    guard head - tail + skipped + count <= capacity else { return nil }
+    return (skipped > 0 ? 0 : position, skipped)
+  }
+
+  /// Starts an empty ring afresh at offset 0, so that it can take a payload
+  /// of its full capacity wherever the last one ended.
+  private mutating func realignIfEmpty() {
+    guard outstanding.isEmpty else { return }
+    head = (head + capacity - 1) / capacity * capacity
+    tail = head
+  }
+
+  mutating func reserve(_ count: Int) -> Reservation? {
+    realignIfEmpty()
+    guard let placement = placement(of: count) else { return nil }
+    head += placement.skipped + count
+    let reservation = Reservation(sequence: nextSequence, offset: placement.offset)
+    outstanding.append((nextSequence, head, false))
+    nextSequence += 1
+    return reservation
+  }
+
+  /// As `reserve(_:)`, but only once every earlier waiter has been served.
+  mutating func reserveUnlessWaiting(_ count: Int) -> Reservation? {
+    waiters.isEmpty ? reserve(count) : nil
+  }
+
+  /// Marks `sequence` released, and returns the waiters the reclaimed space
+  /// was reserved for, with their reservations.
+  mutating func release(
+    _ sequence: Int64
+  ) -> [(CheckedContinuation<Reservation, Never>, Reservation)] {
+    guard let index = outstanding.firstIndex(where: { $0.sequence == sequence }) else {
+      return []
+    }
+    outstanding[index].isReleased = true
+    let reclaimed = outstanding.prefix { $0.isReleased }.count
+    guard reclaimed > 0 else { return [] }
+    tail = outstanding[reclaimed - 1].end
+    outstanding.removeFirst(reclaimed)
+    realignIfEmpty()
+
+    // first come, first served: stopping at the first waiter that does not fit,
+    // rather than serving those behind it, keeps a large payload from starving
+    var served = [(CheckedContinuation<Reservation, Never>, Reservation)]()
+    while let waiter = waiters.first, let reservation = reserve(waiter.count) {
+      waiters.removeFirst()
+      served.append((waiter.continuation, reservation))
+    }
+    return served
+  }
+}
+#endif
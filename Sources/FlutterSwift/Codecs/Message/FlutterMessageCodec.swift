@@ -28,4 +28,18 @@ public protocol FlutterMessageCodec: Sendable {
 
   func encode<T: Encodable>(_ message: T) throws -> Data
   func decode<T: Decodable>(_ message: Data) throws -> T
+
+  /// Decodes a message the caller only lends for the duration of the call, such
+  /// as the engine-owned buffer behind an incoming platform message.
+  ///
+  /// The decoded value must not reference `message`. The default implementation
+  /// copies it into `Data` and calls `decode(_:)`; codecs that can read the
+  /// bytes in place override it.
+  func decode<T: Decodable>(borrowing message: UnsafeRawBufferPointer) throws -> T
+}
+
+public extension FlutterMessageCodec {
+  func decode<T: Decodable>(borrowing message: UnsafeRawBufferPointer) throws -> T {
+    try decode(Data(message))
+  }
 }
@@ -48,11 +48,57 @@ import Foundation
 public final class FlutterStandardMessageCodec: FlutterMessageCodec {
   public static let shared: FlutterStandardMessageCodec = .init()
 
+  /// Where the encoder's scratch buffers come from.
+  public let bufferPool: FlutterStandardBufferPool
+  /// Whether `AnyFlutterStandardCodable` messages are measured before they are
+  /// written, so their buffer is allocated once at its exact size.
+  public let presizesExactly: Bool
+  /// Resolves the string map keys of decoded messages to shared strings.
+  public let stringInterner: FlutterStandardStringInterner?
+
+  /// Creates a codec. Pass a dedicated `bufferPool` to keep a channel's encode
+  /// buffers apart from those of every other channel, `presizesExactly` for
+  /// channels carrying large nested `AnyFlutterStandardCodable` values, and a
+  /// `stringInterner` for channels whose messages repeat the same map keys.
+  public init(
+    bufferPool: FlutterStandardBufferPool = .shared,
+    presizesExactly: Bool = false,
+    stringInterner: FlutterStandardStringInterner? = nil
+  ) {
+    self.bufferPool = bufferPool
+    self.presizesExactly = presizesExactly
+    self.stringInterner = stringInterner
+  }
+
   public func encode<T>(_ message: T) throws -> Data where T: Encodable {
-    try FlutterStandardEncoder().encode(message)
+    try FlutterStandardEncoder(bufferPool: bufferPool, presizesExactly: presizesExactly)
+      .encode(message)
+  }
+
+  /// Encodes `message` as a list of segments whose concatenation is what
+  /// `encode(_:)` returns, for a sender that can gather them.
+  ///
+  /// Payloads of at least `minimumSegmentSize` bytes that the message holds as
+  /// `Data` or `FlutterStandardTypedArray` are returned as segments sharing
+  /// their storage, rather than copied into the encoding. Everything else is
+  /// encoded as usual, between them.
+  public func encodeSegments<T>(
+    _ message: T,
+    minimumSegmentSize: Int = 64 * 1024
+  ) throws -> [Data] where T: Encodable {
+    try FlutterStandardEncoder(bufferPool: bufferPool)
+      .encodeSegments(message, minimumSegmentSize: minimumSegmentSize)
   }
 
   public func decode<T>(_ message: Data) throws -> T where T: Decodable {
-    try FlutterStandardDecoder().decode(T.self, from: message)
+    try FlutterStandardDecoder(stringInterner: stringInterner).decode(T.self, from: message)
+  }
+
+  /// Decodes straight from the borrowed bytes: the standard decoder copies
+  /// everything it keeps into the decoded value, so nothing outlives the call.
+  public func decode<T>(borrowing message: UnsafeRawBufferPointer) throws -> T
+    where T: Decodable
+  {
+    try FlutterStandardDecoder(stringInterner: stringInterner).decode(T.self, from: message)
   }
 }
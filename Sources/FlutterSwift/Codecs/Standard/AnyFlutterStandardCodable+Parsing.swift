@@ -39,7 +39,12 @@ extension AnyFlutterStandardCodable: ExpressibleByParsing {
     }
   }
 
-  init(parsingValue input: inout ParserSpan) throws(ParsingError) {
+  /// Parses one value. With an `interner`, string map keys at any depth are
+  /// resolved through it; see `FlutterStandardStringInterner`.
+  init(
+    parsingValue input: inout ParserSpan,
+    interning interner: FlutterStandardStringInterner? = nil
+  ) throws(ParsingError) {
     switch try FlutterStandardField(parsing: &input) {
     case .nil:
       self = .nil
@@ -71,7 +76,7 @@ extension AnyFlutterStandardCodable: ExpressibleByParsing {
       var values = [AnyFlutterStandardCodable]()
       values.reserveCapacity(count)
       for _ in 0..<count {
-        try values.append(AnyFlutterStandardCodable(parsingValue: &input))
+        try values.append(AnyFlutterStandardCodable(parsingValue: &input, interning: interner))
       }
       self = .list(values)
     case .map:
@@ -80,8 +85,8 @@ extension AnyFlutterStandardCodable: ExpressibleByParsing {
         minimumCapacity: count
       )
       for _ in 0..<count {
-        let key = try AnyFlutterStandardCodable(parsingValue: &input)
-        let value = try AnyFlutterStandardCodable(parsingValue: &input)
+        let key = try AnyFlutterStandardCodable(parsingKey: &input, interning: interner)
+        let value = try AnyFlutterStandardCodable(parsingValue: &input, interning: interner)
         values[key] = value
       }
       self = .map(values)
@@ -92,6 +97,24 @@ extension AnyFlutterStandardCodable: ExpressibleByParsing {
   }
 }
 
+extension AnyFlutterStandardCodable {
+  /// Parses a map key, interning it if it is a string and there is an
+  /// `interner`.
+  private init(
+    parsingKey input: inout ParserSpan,
+    interning interner: FlutterStandardStringInterner?
+  ) throws(ParsingError) {
+    guard let interner,
+          input.withUnsafeBytes({ $0.first == FlutterStandardField.string.rawValue })
+    else {
+      try self.init(parsingValue: &input, interning: interner)
+      return
+    }
+    try input.seek(toRelativeOffset: 1)
+    self = try .string(input.parseString(interning: interner))
+  }
+}
+
 extension AnyFlutterStandardCodable: Decodable {
   public init(from decoder: any Decoder) throws {
     guard let decoder = decoder as? FlutterStandardDecoderImpl else {
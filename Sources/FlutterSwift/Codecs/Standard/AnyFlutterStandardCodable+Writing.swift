@@ -127,6 +127,26 @@ extension AnyFlutterStandardCodable {
   /// Buffer size assumed for nested containers, and for the sizes `hint`
   /// cannot represent. Geometric growth takes over from here.
   static let _defaultSizeHint = 64
+
+  /// The exact size of this value as a whole message, alignment padding
+  /// included.
+  ///
+  /// Unlike the size hint this walks the entire value, which costs about as
+  /// much as encoding it minus the copying. That buys a single, precisely
+  /// sized buffer for large nested values — maps of lists of typed data — which
+  /// would otherwise be reallocated as they grow. Throws wherever encoding
+  /// would.
+  public func encodedByteCount() throws(FlutterSwiftError) -> Int {
+    try _encodedByteCount(at: 0)
+  }
+
+  /// As `encodedByteCount()`, for a value starting `offset` bytes into the
+  /// message, which decides how much padding its aligned fields need.
+  func _encodedByteCount(at offset: Int) throws(FlutterSwiftError) -> Int {
+    var counter = FlutterStandardByteCounter(startingAt: offset)
+    try write(into: &counter)
+    return counter.writtenByteCount - offset
+  }
 }
 
 // MARK: - direct encoding entry points
@@ -134,11 +154,26 @@ extension AnyFlutterStandardCodable {
 /// A value that can produce a whole standard-codec message without `Codable`.
 ///
 /// `FlutterStandardEncoder.encode` checks for this before building an encoding
-/// state. Returning `nil` means "no direct path for this value" and falls back
+/// state. Returning `false` means "no direct path for this value" and falls back
 /// to the `Codable` encoder, so a conformance only has to cover the shapes it
-/// actually benefits from.
+/// actually benefits from; it must decline before writing anything.
 protocol FlutterStandardDirectlyEncodable {
-  func _directlyEncoded() throws(FlutterSwiftError) -> Data?
+  /// Writes the whole message to `buffer`, which is empty and usually pooled.
+  func _directlyEncode(into buffer: inout [UInt8]) throws(FlutterSwiftError) -> Bool
+
+  /// The exact size `_directlyEncode(into:)` will write, or `nil` wherever it
+  /// would decline.
+  func _directlyEncodedByteCount() throws(FlutterSwiftError) -> Int?
+}
+
+extension FlutterStandardDirectlyEncodable {
+  /// The message as `Data`, or `nil` if there is no direct path for it.
+  func _directlyEncoded() throws(FlutterSwiftError) -> Data? {
+    var buffer = [UInt8]()
+    guard try _directlyEncode(into: &buffer) else { return nil }
+    // an unpooled buffer, so its storage can be given away
+    return Data(adopting: buffer)
+  }
 }
 
 /// `[UInt8]` rather than `Data` as the scratch buffer: its appends are 3-8x
@@ -147,11 +182,14 @@ protocol FlutterStandardDirectlyEncodable {
 /// direct path is a wash with the `Codable` one either way, so there is nothing
 /// to be gained by picking a buffer per payload size.
 extension AnyFlutterStandardCodable: FlutterStandardDirectlyEncodable {
-  func _directlyEncoded() throws(FlutterSwiftError) -> Data? {
-    var buffer = [UInt8]()
+  func _directlyEncode(into buffer: inout [UInt8]) throws(FlutterSwiftError) -> Bool {
     buffer.reserveCapacity(_encodedSizeHint)
     try write(into: &buffer)
-    return Data(buffer)
+    return true
+  }
+
+  func _directlyEncodedByteCount() throws(FlutterSwiftError) -> Int? {
+    try encodedByteCount()
   }
 }
 
@@ -164,9 +202,8 @@ extension AnyFlutterStandardCodable: FlutterStandardDirectlyEncodable {
 extension FlutterEnvelope: FlutterStandardDirectlyEncodable
   where Success == AnyFlutterStandardCodable
 {
-  func _directlyEncoded() throws(FlutterSwiftError) -> Data? {
-    guard case let .success(value) = self else { return nil }
-    var buffer = [UInt8]()
+  func _directlyEncode(into buffer: inout [UInt8]) throws(FlutterSwiftError) -> Bool {
+    guard case let .success(value) = self else { return false }
     buffer.reserveCapacity((value?._encodedSizeHint ?? 1) + 1)
     buffer.writeByte(0) // success discriminant
     if let value {
@@ -174,6 +211,12 @@ extension FlutterEnvelope: FlutterStandardDirectlyEncodable
     } else {
       buffer.writeField(.nil)
     }
-    return Data(buffer)
+    return true
+  }
+
+  func _directlyEncodedByteCount() throws(FlutterSwiftError) -> Int? {
+    guard case let .success(value) = self else { return nil }
+    // the payload starts after the one-byte discriminant
+    return try 1 + (value?._encodedByteCount(at: 1) ?? 1)
   }
 }
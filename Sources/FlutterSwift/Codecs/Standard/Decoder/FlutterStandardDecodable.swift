@@ -0,0 +1,271 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import BinaryParsing
+
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/// A type that parses itself from the standard codec directly, bypassing the
+/// `Decoder` machinery.
+///
+/// The mirror image of `FlutterStandardEncodable`. A synthesized `Decodable`
+/// conformance reads each field through a keyed container that accepts every
+/// key, with a fresh `ParserSpan` built per scalar and a `codingPath` array per
+/// nested container. A conformance to this protocol reads the same fields in
+/// the same order from a single span, using the `init(parsingStandard:)`
+/// initializers below, and is used wherever the standard decoder meets the
+/// type — at the top level or nested inside a `Decodable` graph.
+///
+/// It must accept exactly what the type's `Decodable` conformance accepts:
+///
+/// ```swift
+/// struct Resize: Codable, FlutterStandardDecodable {
+///   let width: Int32
+///   let height: Int32
+///   let title: String?
+///
+///   init(parsing input: inout ParserSpan) throws(ParsingError) {
+///     width = try Int32(parsingStandard: &input)
+///     height = try Int32(parsingStandard: &input)
+///     title = try input.parseStandardNil() ? nil : String(parsingStandard: &input)
+///   }
+/// }
+/// ```
+///
+/// Failures are `ParsingError`s carrying a `FlutterSwiftError` as their
+/// `userError`; the decoder unwraps them, so callers see the same errors as on
+/// the `Decodable` path.
+public protocol FlutterStandardDecodable: Decodable {
+  init(parsing input: inout ParserSpan) throws(ParsingError)
+}
+
+// MARK: - scalars
+
+// Each of these reads what the `Codable` encoder writes for its type, and
+// accepts what `FlutterStandardDecodingState` accepts: narrow integers from
+// int32 (range-checked), `Int` and `UInt` at the platform width, `Float` from
+// float64.
+
+public extension Bool {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    let field = try FlutterStandardField(parsing: &input)
+    switch field {
+    case .true:
+      self = true
+    case .false:
+      self = false
+    default:
+      throw ParsingError(userError: FlutterSwiftError.unexpectedStandardFieldType(field))
+    }
+  }
+}
+
+public extension Int32 {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try input.parseAssertedField(.int32)
+    try self.init(parsing: &input, endianness: .host)
+  }
+}
+
+public extension Int64 {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try input.parseAssertedField(.int64)
+    try self.init(parsing: &input, endianness: .host)
+  }
+}
+
+public extension Int {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    if MemoryLayout<Int>.size == 8 {
+      try self.init(Int64(parsingStandard: &input))
+    } else {
+      try self.init(Int32(parsingStandard: &input))
+    }
+  }
+}
+
+/// Narrows an int32 the way the decoding state does, rejecting what does not
+/// fit rather than truncating it.
+private func narrowing<T: FixedWidthInteger>(
+  _ input: inout ParserSpan
+) throws(ParsingError) -> T {
+  guard let value = try T(exactly: Int32(parsingStandard: &input)) else {
+    throw ParsingError(userError: FlutterSwiftError.integerOutOfRange)
+  }
+  return value
+}
+
+public extension Int8 {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    self = try narrowing(&input)
+  }
+}
+
+public extension Int16 {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    self = try narrowing(&input)
+  }
+}
+
+public extension UInt8 {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    self = try narrowing(&input)
+  }
+}
+
+public extension UInt16 {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    self = try narrowing(&input)
+  }
+}
+
+public extension UInt32 {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try self.init(bitPattern: Int32(parsingStandard: &input))
+  }
+}
+
+public extension UInt64 {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try self.init(bitPattern: Int64(parsingStandard: &input))
+  }
+}
+
+public extension UInt {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    guard let value = try UInt(exactly: Int(parsingStandard: &input)) else {
+      throw ParsingError(userError: FlutterSwiftError.integerOutOfRange)
+    }
+    self = value
+  }
+}
+
+public extension Double {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try input.parseAssertedField(.float64)
+    self = try input.parseFloat64()
+  }
+}
+
+public extension Float {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try self.init(Double(parsingStandard: &input))
+  }
+}
+
+public extension String {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try input.parseAssertedField(.string)
+    self = try input.parseString()
+  }
+}
+
+public extension [Substring] {
+  /// Reads a list of strings as substrings of one shared `String`; see
+  /// `FlutterStandardValueView.stringList()`.
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    self = try input.parseStringList()
+  }
+}
+
+// MARK: - byte and typed data
+
+public extension Data {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try input.parseAssertedField(.uint8Data)
+    self = try input.parseData()
+  }
+}
+
+public extension [UInt8] {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try input.parseAssertedField(.uint8Data)
+    self = try input.parseTypedArray(of: UInt8.self)
+  }
+}
+
+public extension [Int32] {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try input.parseAssertedField(.int32Data)
+    self = try input.parseTypedArray(of: Int32.self)
+  }
+}
+
+public extension [Int64] {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try input.parseAssertedField(.int64Data)
+    self = try input.parseTypedArray(of: Int64.self)
+  }
+}
+
+public extension [Float] {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try input.parseAssertedField(.float32Data)
+    self = try input.parseTypedArray(of: Float.self)
+  }
+}
+
+public extension [Double] {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try input.parseAssertedField(.float64Data)
+    self = try input.parseTypedArray(of: Double.self)
+  }
+}
+
+// MARK: - composite values
+
+public extension AnyFlutterStandardCodable {
+  init(parsingStandard input: inout ParserSpan) throws(ParsingError) {
+    try self.init(parsingValue: &input)
+  }
+}
+
+public extension ParserSpan {
+  /// Consumes a `nil` tag if one is next, and reports whether it did: the
+  /// counterpart of `decodeNil()`, for optional fields.
+  #if compiler(<6.3)
+  @_lifetime(&self)
+  #endif
+  mutating func parseStandardNil() throws(ParsingError) -> Bool {
+    let isNil = withUnsafeBytes { $0.first == FlutterStandardField.nil.rawValue }
+    if isNil {
+      try seek(toRelativeOffset: 1)
+    }
+    return isNil
+  }
+
+  /// Reads a list header, returning the number of elements that follow.
+  #if compiler(<6.3)
+  @_lifetime(&self)
+  #endif
+  mutating func parseStandardListHeader() throws(ParsingError) -> Int {
+    try parseAssertedField(.list)
+    return try parseSize()
+  }
+
+  /// Reads a map header, returning the number of key-value pairs that follow.
+  #if compiler(<6.3)
+  @_lifetime(&self)
+  #endif
+  mutating func parseStandardMapHeader() throws(ParsingError) -> Int {
+    try parseAssertedField(.map)
+    return try parseSize()
+  }
+}
@@ -28,21 +28,54 @@ import Foundation
 
 /// A decoder that decodes Swift structures from a flat binary representation.
 public struct FlutterStandardDecoder {
+  /// Resolves string map keys to shared strings; see
+  /// `FlutterStandardStringInterner`.
+  public var stringInterner: FlutterStandardStringInterner?
+
+  public init(stringInterner: FlutterStandardStringInterner? = nil) {
+    self.stringInterner = stringInterner
+  }
+
   /// Decodes a value from a flat binary representation.
   public func decode<Value>(_ type: Value.Type, from data: Data) throws -> Value
     where Value: Decodable
   {
-    if Value.self is ExpressibleByNilLiteral.Type, data.count == 0 {
-      // FIXME: abstraction violation
-      return Any?.none as! Value
-    }
-
     // The decoding state borrows these bytes rather than copying the message,
     // so the whole decode has to happen inside this scope. Containers created
     // during the decode must not escape it; see `FlutterStandardDecodingState`.
-    return try data.withUnsafeBytes { bytes in
-      let state = FlutterStandardDecodingState(bytes: bytes)
-      return try FlutterStandardDecodingState.decode(type, state: state, codingPath: [])
+    // Passing `data` along lets `FlutterStandardTypedArray` retain it rather
+    // than copy out of it.
+    try data.withUnsafeBytes { bytes in
+      try decode(type, from: bytes, message: data)
     }
   }
+
+  /// Decodes a value from a borrowed flat binary representation.
+  ///
+  /// `bytes` need only stay valid for the duration of the call: every value
+  /// the decoder produces owns its storage.
+  public func decode<Value>(
+    _ type: Value.Type,
+    from bytes: UnsafeRawBufferPointer
+  ) throws -> Value where Value: Decodable {
+    try decode(type, from: bytes, message: nil)
+  }
+
+  private func decode<Value>(
+    _ type: Value.Type,
+    from bytes: UnsafeRawBufferPointer,
+    message: Data?
+  ) throws -> Value where Value: Decodable {
+    if Value.self is ExpressibleByNilLiteral.Type, bytes.count == 0 {
+      // FIXME: abstraction violation
+      return Any?.none as! Value
+    }
+
+    let state = FlutterStandardDecodingState(
+      bytes: bytes,
+      message: message,
+      stringInterner: stringInterner
+    )
+    return try FlutterStandardDecodingState.decode(type, state: state, codingPath: [])
+  }
 }
@@ -42,6 +42,12 @@ import Foundation
 /// `AnyFlutterStandardCodable`'s direct (non-`Codable`) parser, so there is one
 /// implementation of sizes, alignment, strings and typed data rather than two.
 ///
+/// The exception is the fixed-size scalars — tags, booleans, int32, int64 and
+/// float64 — which a message of thousands of numbers is mostly made of. Their
+/// grammar is a tag and a load, so they read the buffer in place (`load(_:)`)
+/// rather than paying for a span per token. They raise the same errors the
+/// span would.
+///
 /// - Important: decoding containers must not outlive the `decode` call that
 ///   created them — the same constraint `JSONDecoder` places on its own buffer
 ///   view. Nothing in `Codable`'s API encourages that, but a `Decodable`
@@ -50,12 +56,26 @@ import Foundation
 final class FlutterStandardDecodingState {
   private let bytes: UnsafeRawBufferPointer
   private var offset: Int
+  /// The `Data` that `bytes` are the storage of, if the caller has one, so
+  /// that decoded values may retain it rather than copy out of it.
+  private let message: Data?
+  /// Resolves string map keys to shared strings, if set.
+  let stringInterner: FlutterStandardStringInterner?
 
   var isAtEnd: Bool { offset >= bytes.count }
 
-  init(bytes: UnsafeRawBufferPointer) {
+  /// `offset` is where in `bytes` the value to decode starts; alignment is
+  /// still measured from the start of `bytes`, which must be the whole message.
+  init(
+    bytes: UnsafeRawBufferPointer,
+    offset: Int = 0,
+    message: Data? = nil,
+    stringInterner: FlutterStandardStringInterner? = nil
+  ) {
     self.bytes = bytes
-    offset = 0
+    self.offset = offset
+    self.message = message
+    self.stringInterner = stringInterner
   }
 
   /// Runs `body` against a parser positioned at the cursor, then adopts the
@@ -94,9 +114,34 @@ final class FlutterStandardDecodingState {
   }
 
   func assertStandardField(_ assertedFieldType: FlutterStandardField) throws(FlutterSwiftError) {
-    try withParser { span throws(ParsingError) in
-      try span.parseAssertedField(assertedFieldType)
+    let fieldType = try peekStandardField()
+    guard fieldType == assertedFieldType else {
+      throw FlutterSwiftError.unexpectedStandardFieldType(fieldType)
+    }
+    offset += 1
+  }
+
+  /// Reads a fixed-size value at the cursor, in host byte order, as
+  /// `T(parsing:endianness: .host)` would.
+  private func load<T: BitwiseCopyable>(_ type: T.Type) throws(FlutterSwiftError) -> T {
+    guard bytes.count - offset >= MemoryLayout<T>.size else {
+      throw FlutterSwiftError.eofTooEarly
+    }
+    let value = bytes.loadUnaligned(fromByteOffset: offset, as: T.self)
+    offset += MemoryLayout<T>.size
+    return value
+  }
+
+  /// Skips the padding that aligns the cursor to `alignment`, as
+  /// `ParserSpan.parseAlignment(to:)` does: measured from the message start.
+  private func skipAlignment(_ alignment: Int) throws(FlutterSwiftError) {
+    let mod = offset % alignment
+    guard mod != 0 else { return }
+    let padding = alignment - mod
+    guard padding <= bytes.count - offset else {
+      throw FlutterSwiftError.invalidAlignment
     }
+    offset += padding
   }
 
   private func decodeSize() throws(FlutterSwiftError) -> Int {
@@ -159,6 +204,20 @@ final class FlutterStandardDecodingState {
     try decodeTypedArray(.float32Data, type)
   }
 
+  /// Reads typed data without copying it, where `message` allows.
+  func decodeTypedArray<Element>(
+    _ type: FlutterStandardTypedArray<Element>.Type
+  ) throws(FlutterSwiftError) -> FlutterStandardTypedArray<Element> {
+    let range = try withParser { span throws(ParsingError) in
+      try span.parseAssertedField(Element.standardTypedDataField)
+      let byteCount = try span.parseTypedArrayHeader(of: Element.self).byteCount
+      let start = span.startPosition
+      try span.seek(toRelativeOffset: byteCount)
+      return start..<(start + byteCount)
+    }
+    return FlutterStandardTypedArray(elementsIn: range, of: bytes, message: message)
+  }
+
   func decodeList<Value: Decodable>(
     _ type: Value.Type,
     codingPath: [CodingKey]
@@ -183,7 +242,12 @@ final class FlutterStandardDecodingState {
     let count = try decodeSize()
     var values = [Key: Value](minimumCapacity: count)
     for _ in 0..<count {
-      let key = try decode(Key.self, codingPath: codingPath)
+      let key: Key
+      if Key.self == String.self, let stringInterner {
+        key = try decodeString(interning: stringInterner) as! Key
+      } else {
+        key = try decode(Key.self, codingPath: codingPath)
+      }
       let value = try decode(Value.self, codingPath: codingPath)
       values[key] = value
     }
@@ -191,16 +255,16 @@ final class FlutterStandardDecodingState {
   }
 
   func decode(_ type: Bool.Type) throws(FlutterSwiftError) -> Bool {
-    try withParser { span throws(ParsingError) in
-      let fieldType = try FlutterStandardField(parsing: &span)
-      switch fieldType {
-      case .true:
-        return true
-      case .false:
-        return false
-      default:
-        throw ParsingError(userError: FlutterSwiftError.unexpectedStandardFieldType(fieldType))
-      }
+    let fieldType = try peekStandardField()
+    switch fieldType {
+    case .true:
+      offset += 1
+      return true
+    case .false:
+      offset += 1
+      return false
+    default:
+      throw FlutterSwiftError.unexpectedStandardFieldType(fieldType)
     }
   }
 
@@ -211,13 +275,21 @@ final class FlutterStandardDecodingState {
     }
   }
 
-  func decode(_ type: Double.Type) throws(FlutterSwiftError) -> Double {
+  private func decodeString(
+    interning interner: FlutterStandardStringInterner
+  ) throws(FlutterSwiftError) -> String {
     try withParser { span throws(ParsingError) in
-      try span.parseAssertedField(.float64)
-      return try span.parseFloat64()
+      try span.parseAssertedField(.string)
+      return try span.parseString(interning: interner)
     }
   }
 
+  func decode(_ type: Double.Type) throws(FlutterSwiftError) -> Double {
+    try assertStandardField(.float64)
+    try skipAlignment(MemoryLayout<Double>.alignment)
+    return try Double(bitPattern: load(UInt64.self))
+  }
+
   func decode(_ type: Float.Type) throws(FlutterSwiftError) -> Float {
     try Float(decode(Double.self))
   }
@@ -247,17 +319,13 @@ final class FlutterStandardDecodingState {
   }
 
   func decode(_ type: Int32.Type) throws(FlutterSwiftError) -> Int32 {
-    try withParser { span throws(ParsingError) in
-      try span.parseAssertedField(.int32)
-      return try Int32(parsing: &span, endianness: .host)
-    }
+    try assertStandardField(.int32)
+    return try load(Int32.self)
   }
 
   func decode(_ type: Int64.Type) throws(FlutterSwiftError) -> Int64 {
-    try withParser { span throws(ParsingError) in
-      try span.parseAssertedField(.int64)
-      return try Int64(parsing: &span, endianness: .host)
-    }
+    try assertStandardField(.int64)
+    return try load(Int64.self)
   }
 
   func decode(_ type: UInt.Type) throws(FlutterSwiftError) -> UInt {
@@ -301,7 +369,15 @@ final class FlutterStandardDecodingState {
   /// value costs a single `withParser` call — no decoder, no containers.
   func decodeAnyValue() throws(FlutterSwiftError) -> AnyFlutterStandardCodable {
     try withParser { span throws(ParsingError) in
-      try AnyFlutterStandardCodable(parsingValue: &span)
+      try AnyFlutterStandardCodable(parsingValue: &span, interning: stringInterner)
+    }
+  }
+
+  /// Parse a `FlutterStandardDecodable` value at the current position, inside
+  /// one `withParser` call however many fields it has.
+  func decode<T: FlutterStandardDecodable>(parsing type: T.Type) throws(FlutterSwiftError) -> T {
+    try withParser { span throws(ParsingError) in
+      try T(parsing: &span)
     }
   }
 
@@ -326,6 +402,21 @@ final class FlutterStandardDecodingState {
       case is AnyFlutterStandardCodable.Type:
         // parsed directly, without a decoder or container
         value = try state.decodeAnyValue() as! T
+      // Scalars reached here — list elements, map keys and values, top-level
+      // messages — are read directly too, rather than through a decoder and a
+      // single-value container allocated per element.
+      case is String.Type:
+        value = try state.decode(String.self) as! T
+      case is Bool.Type:
+        value = try state.decode(Bool.self) as! T
+      case is Int.Type:
+        value = try state.decode(Int.self) as! T
+      case is Int32.Type:
+        value = try state.decode(Int32.self) as! T
+      case is Int64.Type:
+        value = try state.decode(Int64.self) as! T
+      case is Double.Type:
+        value = try state.decode(Double.self) as! T
       case is Data.Type:
         value = try state.decodeData() as! T
       case is [UInt8].Type:
@@ -338,6 +429,10 @@ final class FlutterStandardDecodingState {
         value = try state.decodeArray(Float.self) as! T
       case is [Double].Type:
         value = try state.decodeArray(Double.self) as! T
+      case let type as any FlutterStandardDirectlyDecodable.Type:
+        value = try type._directlyDecode(from: state) as! T
+      case let type as any FlutterStandardDecodable.Type:
+        value = try state.decode(parsing: type) as! T
       case is any FlutterListRepresentable.Type:
         try state.assertStandardField(.list)
         count = try state.decodeSize()
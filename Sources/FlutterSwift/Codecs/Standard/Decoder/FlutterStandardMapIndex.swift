@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import BinaryParsing
+
+/// A hash index over the keys of a map in a standard-codec message.
+///
+/// `FlutterStandardValueView.value(forKey:)` finds a key by scanning, which is
+/// right for one or two lookups. A handler that queries the same large map many
+/// times would rather pay for one scan up front and then look keys up in
+/// constant time — without decoding the map into a
+/// `[AnyFlutterStandardCodable: AnyFlutterStandardCodable]`, which allocates
+/// every key and value and hashes every key as an `AnyFlutterStandardCodable`.
+///
+/// The index is a single open-addressed table of (hash, key offset, value
+/// offset) slots, built by hashing each key where it lies in the message
+/// (`ParserSpan.parseKeyHash()`) and skipping each value. Nothing is allocated
+/// per entry. A probe that matches on hash confirms the key against the message
+/// bytes, so collisions cost a comparison, never a wrong answer.
+///
+/// Where a key occurs more than once, lookups find the first occurrence, as
+/// `FlutterStandardValueView.value(forKey:)` does.
+///
+/// The index borrows the message exactly as the view it was made from does,
+/// and is valid for no longer.
+public struct FlutterStandardMapIndex {
+  private struct Slot {
+    var hash: Int
+    /// Offset of the key's type tag, or -1 for an empty slot.
+    var keyOffset: Int
+    var valueOffset: Int
+
+    static let empty = Slot(hash: 0, keyOffset: -1, valueOffset: 0)
+  }
+
+  private let bytes: UnsafeRawBufferPointer
+  private let slots: [Slot]
+
+  /// The number of entries in the map.
+  public let count: Int
+
+  /// Indexes the map `map` views.
+  public init(indexing map: FlutterStandardValueView) throws(FlutterSwiftError) {
+    let (count, first) = try map.containerHeader(.map)
+    // the count is untrusted: every entry takes at least a byte for its key and
+    // one for its value, so a larger count cannot be honest, and must not size
+    // the table
+    guard count <= (map.bytes.count - first) / 2 else {
+      throw FlutterSwiftError.eofTooEarly
+    }
+    // at most half full, so every probe sequence reaches an empty slot quickly
+    var capacity = 1
+    while capacity < count * 2 {
+      capacity <<= 1
+    }
+    let mask = capacity - 1
+    var slots = [Slot](repeating: .empty, count: capacity)
+
+    try FlutterStandardValueView(bytes: map.bytes, offset: first)
+      .withParser { span throws(ParsingError) in
+        for _ in 0..<count {
+          let keyOffset = span.startPosition
+          let hash = try span.parseKeyHash()
+          var index = hash & mask
+          while slots[index].keyOffset >= 0 {
+            index = (index + 1) & mask
+          }
+          slots[index] = Slot(hash: hash, keyOffset: keyOffset, valueOffset: span.startPosition)
+          try span.skipValue()
+        }
+      }
+
+    bytes = map.bytes
+    self.slots = slots
+    self.count = count
+  }
+
+  /// A view of the value stored under the string `key`, or `nil` if there is
+  /// none.
+  public func value(forKey key: String) throws(FlutterSwiftError) -> FlutterStandardValueView? {
+    try probe(Self.hash(key)) { candidate throws(FlutterSwiftError) in
+      try candidate.withParser { span throws(ParsingError) in
+        try span.parseKey(matching: key)
+      }
+    }
+  }
+
+  /// A view of the value stored under `key`, or `nil` if there is none.
+  public func value(
+    forKey key: AnyFlutterStandardCodable
+  ) throws(FlutterSwiftError) -> FlutterStandardValueView? {
+    if case let .string(key) = key {
+      return try value(forKey: key)
+    }
+    return try probe(Self.hash(key)) { candidate throws(FlutterSwiftError) in
+      try candidate.value() == key
+    }
+  }
+
+  private func probe(
+    _ hash: Int,
+    matching matches: (FlutterStandardValueView) throws(FlutterSwiftError) -> Bool
+  ) throws(FlutterSwiftError) -> FlutterStandardValueView? {
+    let mask = slots.count - 1
+    var index = hash & mask
+    while slots[index].keyOffset >= 0 {
+      let slot = slots[index]
+      if slot.hash == hash,
+         try matches(FlutterStandardValueView(bytes: bytes, offset: slot.keyOffset))
+      {
+        return FlutterStandardValueView(bytes: bytes, offset: slot.valueOffset)
+      }
+      index = (index + 1) & mask
+    }
+    return nil
+  }
+
+  // These must hash exactly as `ParserSpan.parseKeyHash()` does on the wire.
+
+  private static func hash(_ key: String) -> Int {
+    var hasher = Hasher()
+    hasher.combine(FlutterStandardField.string)
+    var key = key
+    key.withUTF8 { hasher.combine(bytes: UnsafeRawBufferPointer($0)) }
+    return hasher.finalize()
+  }
+
+  private static func hash(_ key: AnyFlutterStandardCodable) -> Int {
+    var hasher = Hasher()
+    switch key {
+    case let .string(key):
+      return hash(key)
+    case let .int32(value):
+      hasher.combine(FlutterStandardField.int32)
+      hasher.combine(value)
+    case let .int64(value):
+      hasher.combine(FlutterStandardField.int64)
+      hasher.combine(value)
+    default:
+      break
+    }
+    return hasher.finalize()
+  }
+}
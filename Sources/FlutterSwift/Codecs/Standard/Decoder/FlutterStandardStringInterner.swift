@@ -0,0 +1,92 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Synchronization
+
+/// An intern table for the map keys of decoded standard-codec messages.
+///
+/// The messages on a channel tend to be maps with the same dozen keys, every
+/// time. Decoding one allocates a `String` per key that does not fit inline
+/// (more than 15 UTF-8 bytes) and validates the UTF-8 of every key, only to
+/// produce strings identical to the previous message's. With an interner, a
+/// key's raw bytes are hashed and compared against the strings already seen,
+/// and a match hands back the existing `String` — sharing its storage, with no
+/// allocation and no validation.
+///
+/// Only map keys are interned, and only short ones (`maximumLength`): values
+/// rarely repeat, and long strings are not worth a comparison. Once
+/// `maximumCount` distinct keys are held, new keys are decoded as usual rather
+/// than evicting old ones, so a channel that sends unbounded distinct keys
+/// cannot churn the table.
+///
+/// Pass one to `FlutterStandardMessageCodec(stringInterner:)` to scope it to
+/// the channels using that codec. The table is locked, so a codec shared
+/// between channels or threads may share its interner too.
+public final class FlutterStandardStringInterner: Sendable {
+  /// The most distinct strings held.
+  public let maximumCount: Int
+  /// The longest key, in UTF-8 bytes, that is interned.
+  public let maximumLength: Int
+
+  private struct Table {
+    var strings = [Int: [String]]()
+    var count = 0
+  }
+
+  private let table = Mutex(Table())
+
+  public init(maximumCount: Int = 256, maximumLength: Int = 64) {
+    self.maximumCount = maximumCount
+    self.maximumLength = maximumLength
+  }
+
+  /// The string whose UTF-8 is `bytes`, shared with earlier calls where
+  /// possible, or `nil` if `bytes` is not valid UTF-8.
+  func string(for bytes: UnsafeRawBufferPointer) -> String? {
+    guard bytes.count <= maximumLength else {
+      return String(validating: bytes, as: UTF8.self)
+    }
+    var hasher = Hasher()
+    hasher.combine(bytes: bytes)
+    let hash = hasher.finalize()
+
+    if let string = table.withLock({ table in
+      table.strings[hash]?.first { $0.utf8.elementsEqual(bytes) }
+    }) {
+      return string
+    }
+
+    // validated outside the lock; only a miss pays for it
+    guard let string = String(validating: bytes, as: UTF8.self) else {
+      return nil
+    }
+    table.withLock { table in
+      guard table.count < maximumCount,
+            !(table.strings[hash]?.contains(string) ?? false)
+      else {
+        return
+      }
+      table.strings[hash, default: []].append(string)
+      table.count += 1
+    }
+    return string
+  }
+
+  /// The number of distinct strings held.
+  var count: Int {
+    table.withLock { $0.count }
+  }
+}
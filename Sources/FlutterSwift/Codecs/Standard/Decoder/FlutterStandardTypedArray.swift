@@ -0,0 +1,204 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/// An element type of the standard codec's typed data: `UInt8`, `Int32`,
+/// `Int64`, `Float` or `Double`. Other types must not conform.
+public protocol FlutterStandardTypedDataElement: BitwiseCopyable, Codable, Equatable, Sendable {
+  /// The tag of typed data with this element type.
+  static var standardTypedDataField: FlutterStandardField { get }
+}
+
+extension UInt8: FlutterStandardTypedDataElement {
+  public static var standardTypedDataField: FlutterStandardField { .uint8Data }
+}
+
+extension Int32: FlutterStandardTypedDataElement {
+  public static var standardTypedDataField: FlutterStandardField { .int32Data }
+}
+
+extension Int64: FlutterStandardTypedDataElement {
+  public static var standardTypedDataField: FlutterStandardField { .int64Data }
+}
+
+extension Float: FlutterStandardTypedDataElement {
+  public static var standardTypedDataField: FlutterStandardField { .float32Data }
+}
+
+extension Double: FlutterStandardTypedDataElement {
+  public static var standardTypedDataField: FlutterStandardField { .float64Data }
+}
+
+/// Typed data decoded without copying it out of the message.
+///
+/// Decoding `[Float]` or `[Double]` copies every element into a new array,
+/// which for a point cloud or an audio buffer of tens of megabytes is the
+/// single largest cost of receiving the message. Decoding this type instead
+/// keeps a slice of the message `Data`: the message's storage is retained
+/// rather than copied, and `withSpan(_:)` reads the elements where they lie.
+///
+/// That needs the elements to be aligned in memory. The codec pads typed data
+/// to the element size relative to the start of the message, and messages
+/// arrive in freshly allocated storage, so in practice they are; where they
+/// are not — or where the decoder was handed borrowed bytes it cannot retain,
+/// as with `FlutterStandardDecoder.decode(_:from:)` on an
+/// `UnsafeRawBufferPointer` — the elements are copied once, at decode time.
+///
+/// Holding on to a value holds on to the whole message it came from. Copy the
+/// elements out (`Array(value)`) if it is to outlive a small part of a large
+/// message.
+///
+/// On the wire this is exactly `[Element]`, so the two are interchangeable
+/// between sender and receiver.
+public struct FlutterStandardTypedArray<Element: FlutterStandardTypedDataElement>: Sendable {
+  /// The elements' bytes: a slice of the message, or a copy of them.
+  private let storage: Data
+  /// Whether `storage` is a slice of a message rather than a copy.
+  let isSharingMessageStorage: Bool
+
+  public init(_ elements: [Element]) {
+    storage = elements.withUnsafeBytes { Data($0) }
+    isSharingMessageStorage = false
+  }
+
+  /// Adopts the bytes of `data` as the elements, in host byte order, without
+  /// copying them; `nil` if its size is not a whole number of elements.
+  ///
+  /// Together with `Data(bytesNoCopy:count:deallocator:)` or a memory-mapped
+  /// `Data`, this lets a caller encode a buffer it owns — a pixel buffer, a
+  /// mapped file — without first copying it into an array. Encoding into
+  /// segments (`FlutterStandardMessageCodec.encodeSegments(_:minimumSegmentSize:)`)
+  /// then keeps the buffer out of the encoded message, too.
+  public init?(data: Data) {
+    guard data.count % MemoryLayout<Element>.stride == 0 else {
+      return nil
+    }
+    storage = data
+    isSharingMessageStorage = false
+  }
+
+  /// Adopts the `range` of `bytes` as the elements, retaining `message`
+  /// rather than copying where `bytes` are its storage and the elements are
+  /// aligned.
+  init(elementsIn range: Range<Int>, of bytes: UnsafeRawBufferPointer, message: Data?) {
+    if let message, let base = bytes.baseAddress,
+       Int(bitPattern: base + range.lowerBound) % MemoryLayout<Element>.alignment == 0
+    {
+      let start = message.startIndex + range.lowerBound
+      storage = message[start..<(start + range.count)]
+      isSharingMessageStorage = true
+    } else {
+      storage = Data(UnsafeRawBufferPointer(rebasing: bytes[range]))
+      isSharingMessageStorage = false
+    }
+  }
+
+  /// Runs `body` with the elements as a `Span`.
+  public func withSpan<R>(_ body: (Span<Element>) throws -> R) rethrows -> R {
+    try withUnsafeBufferPointer { buffer in
+      try body(buffer.span)
+    }
+  }
+
+  /// Runs `body` with a pointer to the elements, for interop paths that need
+  /// one. The pointer must not escape `body`.
+  public func withUnsafeBufferPointer<R>(
+    _ body: (UnsafeBufferPointer<Element>) throws -> R
+  ) rethrows -> R {
+    try storage.withUnsafeBytes { bytes in
+      if let base = bytes.baseAddress,
+         Int(bitPattern: base) % MemoryLayout<Element>.alignment != 0
+      {
+        // only a short value, which `Data` stores inline, can land here
+        return try Array(self).withUnsafeBufferPointer(body)
+      }
+      return try bytes.withMemoryRebound(to: Element.self, body)
+    }
+  }
+
+  /// Writes the value as typed data, straight from its storage, or with the
+  /// storage gathered rather than written if there is a `gatherer`.
+  func write(
+    into buffer: inout [UInt8],
+    gatherer: FlutterStandardSegmentGatherer?
+  ) throws(FlutterSwiftError) {
+    try buffer.writeTypedDataHeader(
+      Element.standardTypedDataField,
+      count: count,
+      alignment: MemoryLayout<Element>.stride
+    )
+    if let gatherer {
+      gatherer.writePayload(storage, into: &buffer)
+    } else {
+      storage.withUnsafeBytes { buffer.writeBytes($0) }
+    }
+  }
+}
+
+extension FlutterStandardTypedArray: RandomAccessCollection {
+  public var startIndex: Int { 0 }
+  public var endIndex: Int { storage.count / MemoryLayout<Element>.stride }
+
+  public subscript(position: Int) -> Element {
+    precondition(indices.contains(position), "index out of range")
+    return storage.withUnsafeBytes {
+      $0.loadUnaligned(fromByteOffset: position * MemoryLayout<Element>.stride, as: Element.self)
+    }
+  }
+}
+
+extension FlutterStandardTypedArray: Equatable {
+  public static func == (lhs: Self, rhs: Self) -> Bool {
+    lhs.elementsEqual(rhs)
+  }
+}
+
+extension FlutterStandardTypedArray: FlutterStandardEncodable {
+  public func write(to writer: inout FlutterStandardWriter) throws(FlutterSwiftError) {
+    try writer.write(self)
+  }
+
+  /// Other encoders see an `[Element]`.
+  public func encode(to encoder: any Encoder) throws {
+    var container = encoder.singleValueContainer()
+    try container.encode(Array(self))
+  }
+}
+
+extension FlutterStandardTypedArray: Decodable, FlutterStandardDirectlyDecodable {
+  /// Other decoders, which have no message to retain, decode an `[Element]`.
+  public init(from decoder: any Decoder) throws {
+    try self.init(decoder.singleValueContainer().decode([Element].self))
+  }
+
+  static func _directlyDecode(
+    from state: FlutterStandardDecodingState
+  ) throws(FlutterSwiftError) -> Self {
+    try state.decodeTypedArray(Self.self)
+  }
+}
+
+/// A type the decoding state reads itself, bypassing `Decodable`, because it
+/// needs more of the state than a `ParserSpan` offers.
+protocol FlutterStandardDirectlyDecodable {
+  static func _directlyDecode(from state: FlutterStandardDecodingState) throws(FlutterSwiftError)
+    -> Self
+}
@@ -0,0 +1,357 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import BinaryParsing
+
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/// A lazy, read-only view of one value in a standard-codec message.
+///
+/// `AnyFlutterStandardCodable(parsing:)` and `FlutterStandardDecoder` build the
+/// whole value up front: every string validated and copied, every list and
+/// dictionary allocated, every map key hashed. That is the right trade when the
+/// handler uses most of the message. When it reads two keys out of a large
+/// configuration map, it is almost all waste.
+///
+/// A view instead records only where its value starts. Accessors parse just
+/// the bytes they are asked about, and sibling values are stepped over by
+/// their size prefixes (`ParserSpan.skipValue()`) without being materialized.
+/// Lists and maps hand out further views, so a lookup such as
+/// `view.value(forKey: "display")?.value(forKey: "width")?.int()` touches only
+/// the keys it compares and the one integer it returns.
+///
+/// Like `FlutterStandardDecodingState`, a view *borrows* the message rather
+/// than owning it, which is what makes it free to create. The values its
+/// accessors return own their storage, but the view itself, and every view
+/// derived from it, is valid only while the message bytes are: use it inside
+/// `withView(of:_:)`, or within the lifetime of the buffer passed to
+/// `init(borrowing:)` (for example, inside a borrowing message handler).
+public struct FlutterStandardValueView {
+  let bytes: UnsafeRawBufferPointer
+  /// Where this value's type tag sits, measured from the start of the message.
+  let offset: Int
+
+  init(bytes: UnsafeRawBufferPointer, offset: Int) {
+    self.bytes = bytes
+    self.offset = offset
+  }
+
+  /// Creates a view of the message in `bytes`, which must stay valid for as
+  /// long as the view, or any view derived from it, is used.
+  public init(borrowing bytes: UnsafeRawBufferPointer) {
+    self.init(bytes: bytes, offset: 0)
+  }
+
+  /// Runs `body` with a view of `message`.
+  public static func withView<Result>(
+    of message: Data,
+    _ body: (FlutterStandardValueView) throws -> Result
+  ) rethrows -> Result {
+    try message.withUnsafeBytes { bytes in
+      try body(FlutterStandardValueView(borrowing: bytes))
+    }
+  }
+
+  /// Runs `body` against a parser positioned at this value's tag.
+  ///
+  /// The span is rebuilt per call for the same reason as in
+  /// `FlutterStandardDecodingState`: `ParserSpan` is non-escapable and cannot
+  /// be stored. It spans the whole message, so alignment is still measured
+  /// from the message start.
+  func withParser<T>(
+    _ body: (inout ParserSpan) throws(ParsingError) -> T
+  ) throws(FlutterSwiftError) -> T {
+    let bytes = bytes
+    do {
+      var span = ParserSpan(_unsafeBytes: bytes)
+      try span.seek(toAbsoluteOffset: offset)
+      return try body(&span)
+    } catch {
+      throw FlutterSwiftError(error)
+    }
+  }
+
+  /// The offset just past this value, where the next sibling's tag sits.
+  private func endOffset() throws(FlutterSwiftError) -> Int {
+    try withParser { span throws(ParsingError) in
+      try span.skipValue()
+      return span.startPosition
+    }
+  }
+
+  // MARK: - type
+
+  /// The value's type tag.
+  public func field() throws(FlutterSwiftError) -> FlutterStandardField {
+    try withParser { span throws(ParsingError) in
+      try FlutterStandardField(parsing: &span)
+    }
+  }
+
+  /// Whether the value is `nil`. An empty message, which is how an absent
+  /// message arrives, counts as `nil`.
+  public var isNil: Bool {
+    guard offset < bytes.count else { return bytes.isEmpty }
+    return bytes[offset] == FlutterStandardField.nil.rawValue
+  }
+
+  // MARK: - scalars
+
+  public func bool() throws(FlutterSwiftError) -> Bool {
+    try withParser { span throws(ParsingError) in
+      let field = try FlutterStandardField(parsing: &span)
+      switch field {
+      case .true:
+        return true
+      case .false:
+        return false
+      default:
+        throw ParsingError(userError: FlutterSwiftError.unexpectedStandardFieldType(field))
+      }
+    }
+  }
+
+  public func int32() throws(FlutterSwiftError) -> Int32 {
+    try withParser { span throws(ParsingError) in
+      try span.parseAssertedField(.int32)
+      return try Int32(parsing: &span, endianness: .host)
+    }
+  }
+
+  public func int64() throws(FlutterSwiftError) -> Int64 {
+    try withParser { span throws(ParsingError) in
+      try span.parseAssertedField(.int64)
+      return try Int64(parsing: &span, endianness: .host)
+    }
+  }
+
+  /// Reads either integer width. Dart writes an `int` as an int32 whenever it
+  /// fits, so a handler reading a Dart integer cannot know in advance which
+  /// one it will get.
+  public func int() throws(FlutterSwiftError) -> Int {
+    try withParser { span throws(ParsingError) in
+      let field = try FlutterStandardField(parsing: &span)
+      switch field {
+      case .int32:
+        return try Int(Int32(parsing: &span, endianness: .host))
+      case .int64:
+        guard let value = try Int(exactly: Int64(parsing: &span, endianness: .host)) else {
+          throw ParsingError(userError: FlutterSwiftError.integerOutOfRange)
+        }
+        return value
+      default:
+        throw ParsingError(userError: FlutterSwiftError.unexpectedStandardFieldType(field))
+      }
+    }
+  }
+
+  public func double() throws(FlutterSwiftError) -> Double {
+    try withParser { span throws(ParsingError) in
+      try span.parseAssertedField(.float64)
+      return try span.parseFloat64()
+    }
+  }
+
+  public func string() throws(FlutterSwiftError) -> String {
+    try withParser { span throws(ParsingError) in
+      try span.parseAssertedField(.string)
+      return try span.parseString()
+    }
+  }
+
+  /// Reads a list of strings as substrings sharing one backing `String`:
+  /// a single allocation and a single validation pass for the whole list,
+  /// where decoding `[String]` makes one of each per element. See
+  /// `ParserSpan.parseStringList()`.
+  public func stringList() throws(FlutterSwiftError) -> [Substring] {
+    try withParser { span throws(ParsingError) in
+      try span.parseStringList()
+    }
+  }
+
+  // MARK: - typed data
+
+  private func typedArray<T: BitwiseCopyable>(
+    _ field: FlutterStandardField,
+    of type: T.Type
+  ) throws(FlutterSwiftError) -> [T] {
+    try withParser { span throws(ParsingError) in
+      try span.parseAssertedField(field)
+      return try span.parseTypedArray(of: type)
+    }
+  }
+
+  public func array(of type: UInt8.Type) throws(FlutterSwiftError) -> [UInt8] {
+    try typedArray(.uint8Data, of: type)
+  }
+
+  public func array(of type: Int32.Type) throws(FlutterSwiftError) -> [Int32] {
+    try typedArray(.int32Data, of: type)
+  }
+
+  public func array(of type: Int64.Type) throws(FlutterSwiftError) -> [Int64] {
+    try typedArray(.int64Data, of: type)
+  }
+
+  public func array(of type: Float.Type) throws(FlutterSwiftError) -> [Float] {
+    try typedArray(.float32Data, of: type)
+  }
+
+  public func array(of type: Double.Type) throws(FlutterSwiftError) -> [Double] {
+    try typedArray(.float64Data, of: type)
+  }
+
+  // MARK: - materializing
+
+  /// Parses the whole value, for when the handler wants all of it after all.
+  public func value() throws(FlutterSwiftError) -> AnyFlutterStandardCodable {
+    try withParser { span throws(ParsingError) in
+      try AnyFlutterStandardCodable(parsingValue: &span)
+    }
+  }
+
+  /// Decodes the value as `type`, exactly as `FlutterStandardDecoder` would
+  /// had it been the whole message.
+  public func decode<T: Decodable>(_ type: T.Type) throws -> T {
+    let state = FlutterStandardDecodingState(bytes: bytes, offset: offset)
+    return try FlutterStandardDecodingState.decode(type, state: state, codingPath: [])
+  }
+
+  // MARK: - containers
+
+  /// Reads a container's header, returning its element count and the offset
+  /// of its first element.
+  func containerHeader(
+    _ field: FlutterStandardField
+  ) throws(FlutterSwiftError) -> (count: Int, first: Int) {
+    try withParser { span throws(ParsingError) in
+      try span.parseAssertedField(field)
+      let count = try span.parseSize()
+      return (count, span.startPosition)
+    }
+  }
+
+  /// The number of elements in a list, or of entries in a map.
+  public func count() throws(FlutterSwiftError) -> Int {
+    let field = try field()
+    switch field {
+    case .list, .map:
+      return try containerHeader(field).count
+    default:
+      throw FlutterSwiftError.unexpectedStandardFieldType(field)
+    }
+  }
+
+  /// Calls `body` with a view of each element of a list, in order.
+  ///
+  /// Each element is stepped over once to find the next; its contents are
+  /// parsed only if `body` asks for them.
+  public func forEachElement(_ body: (FlutterStandardValueView) throws -> ()) throws {
+    let (count, first) = try containerHeader(.list)
+    var next = first
+    for _ in 0..<count {
+      let element = FlutterStandardValueView(bytes: bytes, offset: next)
+      try body(element)
+      next = try element.endOffset()
+    }
+  }
+
+  /// A view of the list element at `index`. The elements before it are
+  /// skipped, not parsed, but this is still linear in `index`: prefer
+  /// `forEachElement(_:)` to visit several.
+  public func element(at index: Int) throws(FlutterSwiftError) -> FlutterStandardValueView {
+    let (count, first) = try containerHeader(.list)
+    guard index >= 0, index < count else {
+      throw FlutterSwiftError.integerOutOfRange
+    }
+    let offset = try FlutterStandardValueView(bytes: bytes, offset: first)
+      .withParser { span throws(ParsingError) in
+        for _ in 0..<index {
+          try span.skipValue()
+        }
+        return span.startPosition
+      }
+    return FlutterStandardValueView(bytes: bytes, offset: offset)
+  }
+
+  /// Calls `body` with views of each key and value of a map, in wire order.
+  public func forEachEntry(
+    _ body: (_ key: FlutterStandardValueView, _ value: FlutterStandardValueView) throws -> ()
+  ) throws {
+    let (count, first) = try containerHeader(.map)
+    var next = first
+    for _ in 0..<count {
+      let key = FlutterStandardValueView(bytes: bytes, offset: next)
+      let value = try FlutterStandardValueView(bytes: bytes, offset: key.endOffset())
+      try body(key, value)
+      next = try value.endOffset()
+    }
+  }
+
+  /// A view of the value stored under the string `key` in a map, or `nil` if
+  /// there is none.
+  ///
+  /// Keys are compared as raw UTF-8 without building a `String` for each one,
+  /// and the values passed over on the way are skipped, not parsed. The scan
+  /// is still linear in the position of the key; for repeated lookups into one
+  /// large map, build a `FlutterStandardMapIndex` with `makeIndex()`.
+  public func value(forKey key: String) throws(FlutterSwiftError) -> FlutterStandardValueView? {
+    let (count, first) = try containerHeader(.map)
+    let offset = try FlutterStandardValueView(bytes: bytes, offset: first)
+      .withParser { span throws(ParsingError) -> Int? in
+        for _ in 0..<count {
+          if try span.parseKey(matching: key) {
+            return span.startPosition
+          }
+          try span.skipValue()
+        }
+        return nil
+      }
+    return offset.map { FlutterStandardValueView(bytes: bytes, offset: $0) }
+  }
+
+  /// A view of the value stored under `key` in a map, or `nil` if there is
+  /// none. Keys that are not strings are parsed for the comparison; the values
+  /// in between are still only skipped.
+  public func value(
+    forKey key: AnyFlutterStandardCodable
+  ) throws(FlutterSwiftError) -> FlutterStandardValueView? {
+    if case let .string(key) = key {
+      return try value(forKey: key)
+    }
+    let (count, first) = try containerHeader(.map)
+    let offset = try FlutterStandardValueView(bytes: bytes, offset: first)
+      .withParser { span throws(ParsingError) -> Int? in
+        for _ in 0..<count {
+          if try AnyFlutterStandardCodable(parsingValue: &span) == key {
+            return span.startPosition
+          }
+          try span.skipValue()
+        }
+        return nil
+      }
+    return offset.map { FlutterStandardValueView(bytes: bytes, offset: $0) }
+  }
+
+  /// Indexes a map's keys in one pass, for constant-time lookups thereafter.
+  public func makeIndex() throws(FlutterSwiftError) -> FlutterStandardMapIndex {
+    try FlutterStandardMapIndex(indexing: self)
+  }
+}
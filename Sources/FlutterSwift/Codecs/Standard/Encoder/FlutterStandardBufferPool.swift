@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Synchronization
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/// A pool of scratch buffers for the standard-codec writers.
+///
+/// Encoders borrow a buffer from a pool, write into whatever capacity it kept
+/// from earlier messages, and hand it back, so the message bytes themselves are
+/// written without growing or reallocating a buffer once a channel's message
+/// shapes have been seen. What the pool does not remove: the `Data` returned
+/// for each message (unless small enough to be stored inline), and, on the
+/// `Codable` path, the encoding state, its containers and their coding paths.
+///
+/// `FlutterStandardMessageCodec.shared` uses `shared`. A channel with unusually
+/// large or bursty messages can be given a codec with a pool of its own, so its
+/// buffers neither crowd out nor inherit the sizes of everyone else's.
+public final class FlutterStandardBufferPool: Sendable {
+  public static let shared = FlutterStandardBufferPool()
+
+  /// The most buffers kept idle. Beyond this, returned buffers are freed.
+  public let maximumCount: Int
+  /// The largest capacity worth keeping: one huge message must not pin its
+  /// buffer for the life of the process.
+  public let maximumCapacity: Int
+
+  private let buffers = Mutex<[[UInt8]]>([])
+
+  public init(maximumCount: Int = 8, maximumCapacity: Int = 1 << 20) {
+    self.maximumCount = maximumCount
+    self.maximumCapacity = maximumCapacity
+  }
+
+  /// Runs `body` with an empty buffer, which returns to the pool afterwards.
+  ///
+  /// `body` must not let the buffer escape: a copy still sharing its storage
+  /// would make the next borrower's writes copy-on-write it.
+  func withBuffer<T>(_ body: (inout [UInt8]) throws -> T) rethrows -> T {
+    var buffer = buffers.withLock { $0.popLast() } ?? []
+    defer {
+      if buffer.capacity <= maximumCapacity {
+        buffer.removeAll(keepingCapacity: true)
+        buffers.withLock { buffers in
+          if buffers.count < maximumCount {
+            buffers.append(buffer)
+          }
+        }
+      }
+    }
+    return try body(&buffer)
+  }
+
+  /// `buffer`, filled inside `withBuffer(_:)`, as `Data`. A buffer the pool
+  /// will keep is copied out, since the next borrower overwrites it; one too
+  /// large to keep is handed to the `Data` as it is.
+  func data(from buffer: [UInt8]) -> Data {
+    buffer.capacity <= maximumCapacity ? Data(buffer) : Data(adopting: buffer)
+  }
+
+  /// The number of buffers currently idle in the pool.
+  var idleCount: Int {
+    buffers.withLock { $0.count }
+  }
+}
+
+extension Data {
+  /// `buffer`'s bytes, sharing its storage rather than copying it: the `Data`
+  /// holds the array, which nothing may mutate afterwards, until it is freed.
+  init(adopting buffer: [UInt8]) {
+    guard !buffer.isEmpty else {
+      self.init()
+      return
+    }
+    let bytes = buffer.withUnsafeBufferPointer {
+      UnsafeMutableRawPointer(mutating: $0.baseAddress!)
+    }
+    self.init(bytesNoCopy: bytes, count: buffer.count, deallocator: .custom { _, _ in
+      withExtendedLifetime(buffer) {}
+    })
+  }
+}
@@ -0,0 +1,282 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/// A type that writes itself to the standard codec directly, bypassing the
+/// `Encoder` machinery.
+///
+/// A struct's synthesized `Encodable` conformance goes through a keyed
+/// container, an existential `Encoder`, and a `codingPath` append per field,
+/// only for the standard codec to discard the keys: structs are encoded
+/// positionally, field after field. A conformance to this protocol writes the
+/// same fields in the same order as straight-line calls on a
+/// `FlutterStandardWriter`, so that a typical method-call argument struct
+/// encodes in a handful of appends.
+///
+/// The conformance must produce exactly the bytes the type's `Encodable`
+/// conformance would — it is used wherever the standard codec meets the type,
+/// at the top level or nested inside a `Codable` graph, and other encoders
+/// still use `Encodable`. Write each stored property in declaration order with
+/// the `write` overload for its type, and optionals as `encodeIfPresent` does:
+///
+/// ```swift
+/// struct Resize: Codable, FlutterStandardEncodable {
+///   let width: Int32
+///   let height: Int32
+///   let title: String?
+///
+///   func write(to writer: inout FlutterStandardWriter) throws(FlutterSwiftError) {
+///     writer.write(width)
+///     writer.write(height)
+///     if let title {
+///       try writer.write(title)
+///     } else {
+///       writer.writeNil()
+///     }
+///   }
+/// }
+/// ```
+public protocol FlutterStandardEncodable: Encodable {
+  func write(to writer: inout FlutterStandardWriter) throws(FlutterSwiftError)
+}
+
+/// Writes values in the standard codec's wire format, for
+/// `FlutterStandardEncodable` conformances.
+///
+/// Named for the engine's `FlutterStandardWriter` (FlutterCodecs.h), whose
+/// `writeValue:` it plays the part of. Each `write` overload produces the same
+/// bytes as the `Codable` encoder does for that type: narrow integers widen to
+/// int32, `Int` and `UInt` to the platform width, `Float` to float64.
+public struct FlutterStandardWriter {
+  /// The whole message so far: alignment is measured from its start.
+  private var buffer: [UInt8]
+  /// Where large `Data`-backed payloads go when encoding into segments.
+  private let gatherer: FlutterStandardSegmentGatherer?
+
+  private init(buffer: [UInt8], gatherer: FlutterStandardSegmentGatherer?) {
+    self.buffer = buffer
+    self.gatherer = gatherer
+  }
+
+  /// Lends `buffer`'s storage to a writer, taking it back when `body` returns.
+  ///
+  /// As with `FlutterStandardEncodingState.withState`, the storage moves rather
+  /// than being shared, so writes never copy it on write.
+  static func withWriter<T>(
+    writingInto buffer: inout [UInt8],
+    gatherer: FlutterStandardSegmentGatherer? = nil,
+    _ body: (inout FlutterStandardWriter) throws(FlutterSwiftError) -> T
+  ) throws(FlutterSwiftError) -> T {
+    var writer = FlutterStandardWriter(buffer: buffer, gatherer: gatherer)
+    buffer = []
+    defer { swap(&buffer, &writer.buffer) }
+    return try body(&writer)
+  }
+
+  // MARK: - scalars
+
+  public mutating func writeNil() {
+    buffer.writeField(.nil)
+  }
+
+  public mutating func write(_ value: Bool) {
+    buffer.writeField(value ? .true : .false)
+  }
+
+  public mutating func write(_ value: Int32) {
+    buffer.writeInt32(value)
+  }
+
+  public mutating func write(_ value: Int64) {
+    buffer.writeInt64(value)
+  }
+
+  public mutating func write(_ value: Int) {
+    if MemoryLayout<Int>.size == 8 {
+      buffer.writeInt64(Int64(value))
+    } else {
+      buffer.writeInt32(Int32(value))
+    }
+  }
+
+  public mutating func write(_ value: Int8) {
+    buffer.writeInt32(Int32(value))
+  }
+
+  public mutating func write(_ value: Int16) {
+    buffer.writeInt32(Int32(value))
+  }
+
+  public mutating func write(_ value: UInt) {
+    write(Int(value))
+  }
+
+  public mutating func write(_ value: UInt8) {
+    buffer.writeInt32(Int32(value))
+  }
+
+  public mutating func write(_ value: UInt16) {
+    buffer.writeInt32(Int32(value))
+  }
+
+  public mutating func write(_ value: UInt32) {
+    buffer.writeInt32(Int32(bitPattern: value))
+  }
+
+  public mutating func write(_ value: UInt64) {
+    buffer.writeInt64(Int64(bitPattern: value))
+  }
+
+  public mutating func write(_ value: Double) {
+    buffer.writeFloat64(value)
+  }
+
+  public mutating func write(_ value: Float) {
+    // no float32 scalar in the standard codec; promote to float64
+    buffer.writeFloat64(Double(value))
+  }
+
+  public mutating func write(_ value: String) throws(FlutterSwiftError) {
+    try buffer.writeString(value)
+  }
+
+  // MARK: - byte and typed data
+
+  public mutating func write(_ value: Data) throws(FlutterSwiftError) {
+    if let gatherer {
+      try buffer.writeTypedDataHeader(.uint8Data, count: value.count, alignment: 1)
+      gatherer.writePayload(value, into: &buffer)
+    } else {
+      try buffer.writeData(value)
+    }
+  }
+
+  public mutating func write(_ value: [UInt8]) throws(FlutterSwiftError) {
+    try buffer.writeTypedArray(.uint8Data, value)
+  }
+
+  public mutating func write(_ value: [Int32]) throws(FlutterSwiftError) {
+    try buffer.writeTypedArray(.int32Data, value)
+  }
+
+  public mutating func write(_ value: [Int64]) throws(FlutterSwiftError) {
+    try buffer.writeTypedArray(.int64Data, value)
+  }
+
+  public mutating func write(_ value: [Float]) throws(FlutterSwiftError) {
+    try buffer.writeTypedArray(.float32Data, value)
+  }
+
+  public mutating func write(_ value: [Double]) throws(FlutterSwiftError) {
+    try buffer.writeTypedArray(.float64Data, value)
+  }
+
+  /// Writes typed data straight from the storage of `value`.
+  public mutating func write<Element>(
+    _ value: FlutterStandardTypedArray<Element>
+  ) throws(FlutterSwiftError) {
+    try value.write(into: &buffer, gatherer: gatherer)
+  }
+
+  // MARK: - borrowed typed data
+
+  // For elements the caller holds outside an array. Each is copied once,
+  // straight into the message, with no intermediate `[Element]`.
+
+  public mutating func write<Element: FlutterStandardTypedDataElement>(
+    _ elements: UnsafeBufferPointer<Element>
+  ) throws(FlutterSwiftError) {
+    try buffer.writeTypedData(
+      Element.standardTypedDataField,
+      UnsafeRawBufferPointer(elements),
+      stride: MemoryLayout<Element>.stride
+    )
+  }
+
+  public mutating func write<Element: FlutterStandardTypedDataElement>(
+    _ elements: Span<Element>
+  ) throws(FlutterSwiftError) {
+    try elements.withUnsafeBufferPointer { elements throws(FlutterSwiftError) in
+      try write(elements)
+    }
+  }
+
+  /// Writes `bytes` as typed data of `type`: elements in host byte order,
+  /// with no alignment required of `bytes` itself. Throws
+  /// `FlutterSwiftError.fieldNotEncodable` if `bytes` is not a whole number of
+  /// elements.
+  public mutating func write<Element: FlutterStandardTypedDataElement>(
+    _ bytes: UnsafeRawBufferPointer,
+    as type: Element.Type
+  ) throws(FlutterSwiftError) {
+    guard bytes.count % MemoryLayout<Element>.stride == 0 else {
+      throw FlutterSwiftError.fieldNotEncodable
+    }
+    try buffer.writeTypedData(
+      Element.standardTypedDataField,
+      bytes,
+      stride: MemoryLayout<Element>.stride
+    )
+  }
+
+  // MARK: - containers
+
+  /// Starts a list of `count` elements, which the caller then writes.
+  public mutating func writeListHeader(count: Int) throws(FlutterSwiftError) {
+    buffer.writeField(.list)
+    try buffer.writeSize(count)
+  }
+
+  /// Starts a map of `count` entries, which the caller then writes as
+  /// alternating keys and values.
+  public mutating func writeMapHeader(count: Int) throws(FlutterSwiftError) {
+    buffer.writeField(.map)
+    try buffer.writeSize(count)
+  }
+
+  // MARK: - composite values
+
+  public mutating func write(_ value: AnyFlutterStandardCodable) throws(FlutterSwiftError) {
+    try value.write(into: &buffer)
+  }
+
+  public mutating func write(_ value: some FlutterStandardEncodable) throws(FlutterSwiftError) {
+    try value.write(to: &self)
+  }
+
+  /// Writes any other value through its `Encodable` conformance, for fields
+  /// the overloads above do not cover. Correct for every type, but pays for
+  /// the `Encoder` machinery this type otherwise avoids.
+  public mutating func write(_ value: some Encodable) throws(FlutterSwiftError) {
+    do {
+      try FlutterStandardEncodingState.withState(
+        encodingInto: &buffer,
+        gatherer: gatherer
+      ) { state in
+        try state.encode(value, codingPath: [])
+      }
+    } catch let error as FlutterSwiftError {
+      throw error
+    } catch {
+      throw FlutterSwiftError.fieldNotEncodable
+    }
+  }
+}
@@ -27,19 +27,68 @@ import Foundation
 #endif
 
 struct FlutterStandardEncoder {
+  /// Where scratch buffers come from; see `FlutterStandardBufferPool`.
+  var bufferPool: FlutterStandardBufferPool = .shared
+  /// Whether directly encodable values are measured first, so that the buffer
+  /// is allocated once at its final size rather than grown. Worthwhile for
+  /// large nested values; for small ones the pool's recycled capacity already
+  /// avoids the growth, and the measuring pass is pure overhead.
+  var presizesExactly = false
+
   func encode<Value>(_ value: Value) throws -> Data where Value: Encodable {
+    try bufferPool.withBuffer { buffer in
+      try encode(value, into: &buffer)
+      return bufferPool.data(from: buffer)
+    }
+  }
+
+  /// Encodes `value` as a list of segments whose concatenation is the message,
+  /// leaving `Data` and `FlutterStandardTypedArray` payloads of at least
+  /// `minimumSegmentSize` bytes in their own storage rather than copying them
+  /// into it; see `FlutterStandardSegmentGatherer`.
+  func encodeSegments<Value>(
+    _ value: Value,
+    minimumSegmentSize: Int
+  ) throws -> [Data] where Value: Encodable {
+    let gatherer = FlutterStandardSegmentGatherer(minimumSegmentSize: minimumSegmentSize)
+    return try bufferPool.withBuffer { buffer in
+      try encode(value, into: &buffer, gatherer: gatherer)
+      return gatherer.segments(of: buffer)
+    }
+  }
+
+  /// Appends the encoding of `value` to `buffer`, which must be empty: alignment
+  /// is measured from the start of the message.
+  func encode<Value>(
+    _ value: Value,
+    into buffer: inout [UInt8],
+    gatherer: FlutterStandardSegmentGatherer? = nil
+  ) throws where Value: Encodable {
     // Values whose shape is fully determined by their own case — chiefly
     // `AnyFlutterStandardCodable` and the event-channel envelope wrapping it —
     // write their bytes directly, skipping the encoder, containers and the
     // per-value existential cast chain. Everything else, and any value whose
-    // conformance declines (`nil`), takes the `Codable` path unchanged.
-    if let value = value as? any FlutterStandardDirectlyEncodable,
-       let data = try value._directlyEncoded()
-    {
-      return data
+    // conformance declines (`false`), takes the `Codable` path unchanged.
+    if let value = value as? any FlutterStandardDirectlyEncodable {
+      if presizesExactly, let byteCount = try value._directlyEncodedByteCount() {
+        buffer.reserveCapacity(byteCount)
+      }
+      if try value._directlyEncode(into: &buffer) {
+        return
+      }
+    }
+    // user types with a hand-written conformance, likewise without containers
+    if let value = value as? any FlutterStandardEncodable {
+      try FlutterStandardWriter.withWriter(
+        writingInto: &buffer,
+        gatherer: gatherer
+      ) { writer throws(FlutterSwiftError) in
+        try value.write(to: &writer)
+      }
+      return
+    }
+    try FlutterStandardEncodingState.withState(encodingInto: &buffer, gatherer: gatherer) { state in
+      try state.encode(value, codingPath: [])
     }
-    let state = FlutterStandardEncodingState()
-    try state.encode(value, codingPath: [])
-    return state.data
   }
 }
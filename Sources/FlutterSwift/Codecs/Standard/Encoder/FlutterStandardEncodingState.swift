@@ -24,37 +24,78 @@
 import Foundation
 
 final class FlutterStandardEncodingState {
-  private(set) var data: Data = .init()
+  /// `[UInt8]` rather than `Data`: its appends are several times cheaper on the
+  /// small, token-heavy writes the encoder makes, and it is the buffer type
+  /// `FlutterStandardBufferPool` recycles.
+  private var buffer: [UInt8]
+  /// Where large `Data`-backed payloads go when encoding into segments.
+  private let gatherer: FlutterStandardSegmentGatherer?
 
-  init(data: Data = .init()) {
-    self.data = data
+  var data: Data {
+    Data(buffer)
+  }
+
+  init(buffer: [UInt8] = [], gatherer: FlutterStandardSegmentGatherer? = nil) {
+    self.buffer = buffer
+    self.gatherer = gatherer
+  }
+
+  /// Encodes into `buffer`'s storage, handing it back when `body` returns.
+  ///
+  /// The storage moves into the state and back rather than being shared, so
+  /// writes never copy it on write.
+  static func withState<T>(
+    encodingInto buffer: inout [UInt8],
+    gatherer: FlutterStandardSegmentGatherer? = nil,
+    _ body: (FlutterStandardEncodingState) throws -> T
+  ) rethrows -> T {
+    let state = FlutterStandardEncodingState(buffer: buffer, gatherer: gatherer)
+    buffer = []
+    defer { swap(&buffer, &state.buffer) }
+    return try body(state)
   }
 
   private func encodeStandardField(_ fieldType: FlutterStandardField) throws(FlutterSwiftError) {
-    data.writeField(fieldType)
+    buffer.writeField(fieldType)
   }
 
   private func encodeSize(_ size: Int) throws(FlutterSwiftError) {
-    try data.writeSize(size)
+    try buffer.writeSize(size)
   }
 
   private func encodeAlignment(_ alignment: Int) throws(FlutterSwiftError) {
-    data.writeAlignment(alignment)
+    buffer.writeAlignment(alignment)
   }
 
   private func encode(_ value: Data) throws(FlutterSwiftError) {
-    try data.writeData(value)
+    if let gatherer {
+      try buffer.writeTypedDataHeader(.uint8Data, count: value.count, alignment: 1)
+      gatherer.writePayload(value, into: &buffer)
+    } else {
+      try buffer.writeData(value)
+    }
   }
 
   /// Writes an `AnyFlutterStandardCodable` straight into the buffer, bypassing
   /// the encoder and container allocation the `Codable` path would need.
   func write(_ value: AnyFlutterStandardCodable) throws(FlutterSwiftError) {
-    try value.write(into: &data)
+    try value.write(into: &buffer)
+  }
+
+  /// Hands the buffer to a `FlutterStandardEncodable` conformance, which
+  /// writes its fields without a container per value.
+  func write(_ value: some FlutterStandardEncodable) throws(FlutterSwiftError) {
+    try FlutterStandardWriter.withWriter(
+      writingInto: &buffer,
+      gatherer: gatherer
+    ) { writer throws(FlutterSwiftError) in
+      try value.write(to: &writer)
+    }
   }
 
   @inlinable
   func encodeDiscriminant(_ value: UInt8) throws(FlutterSwiftError) {
-    data.append(value)
+    buffer.writeByte(value)
   }
 
   func encodeNil() throws(FlutterSwiftError) {
@@ -74,7 +115,7 @@ final class FlutterStandardEncodingState {
     _ fieldType: FlutterStandardField,
     _ value: [T]
   ) throws(FlutterSwiftError) {
-    try data.writeTypedArray(fieldType, value)
+    try buffer.writeTypedArray(fieldType, value)
   }
 
   private func encodeArray(_ value: [UInt8]) throws(FlutterSwiftError) {
@@ -124,12 +165,12 @@ final class FlutterStandardEncodingState {
     where Integer: FixedWidthInteger
   {
     withUnsafeBytes(of: value) {
-      data += $0
+      buffer.writeBytes($0)
     }
   }
 
   func encode(_ value: String) throws(FlutterSwiftError) {
-    try data.writeString(value)
+    try buffer.writeString(value)
   }
 
   func encode(_ value: Bool) throws(FlutterSwiftError) {
@@ -224,6 +265,8 @@ final class FlutterStandardEncodingState {
       try state.encodeArray(array)
     case let array as [Double] where type(of: value) == [Double].self:
       try state.encodeArray(array)
+    case let value as any FlutterStandardEncodable:
+      try state.write(value)
     case let value as any FlutterListRepresentable:
       try state.encodeList(value, codingPath: codingPath)
     case let value as any FlutterMapRepresentable:
@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/// Keeps large payloads out of the encode buffer, for scatter-gather output.
+///
+/// Encoding a message with a 50 MB blob in it copies the blob into the encode
+/// buffer, then again into the `Data` the codec returns, before the engine
+/// copies it a third time. When encoding into segments instead, a payload the
+/// caller already holds as `Data` — a `Data` value, or the storage of a
+/// `FlutterStandardTypedArray` — is not written to the buffer at all: the
+/// gatherer records it, retained, against the buffer offset where it belongs,
+/// and `segments(of:)` splices the two back together as a list of `Data` whose
+/// concatenation is the message. The blob is copied only by whoever finally
+/// consumes the segments.
+///
+/// Alignment is measured from the message start, which the buffer no longer
+/// is once a payload is missing from it. So only a multiple of 8 bytes — the
+/// largest alignment the codec uses — is ever gathered, and the remainder is
+/// written to the buffer as usual; buffer and message offsets then agree
+/// modulo every alignment, and the writers need not know about the gaps.
+final class FlutterStandardSegmentGatherer {
+  /// Payloads smaller than this are copied into the buffer: a segment has a
+  /// fixed cost for whoever consumes it.
+  let minimumSegmentSize: Int
+
+  private var gathered = [(offset: Int, payload: Data)]()
+
+  init(minimumSegmentSize: Int) {
+    self.minimumSegmentSize = Swift.max(minimumSegmentSize, 8)
+  }
+
+  /// Appends `payload` to `buffer`, or gathers as much of it as may be
+  /// gathered and appends the rest.
+  func writePayload(_ payload: Data, into buffer: inout [UInt8]) {
+    let gatheredCount = payload.count & ~7
+    guard gatheredCount >= minimumSegmentSize else {
+      payload.withUnsafeBytes { buffer.writeBytes($0) }
+      return
+    }
+    let split = payload.startIndex + gatheredCount
+    gathered.append((buffer.count, payload[..<split]))
+    payload[split...].withUnsafeBytes { buffer.writeBytes($0) }
+  }
+
+  /// The message, as `buffer` interleaved with the gathered payloads.
+  ///
+  /// Copies `buffer`'s bytes, so that it can go back to its pool.
+  func segments(of buffer: [UInt8]) -> [Data] {
+    var segments = [Data]()
+    segments.reserveCapacity(gathered.count * 2 + 1)
+    var start = 0
+    for (offset, payload) in gathered {
+      if offset > start {
+        segments.append(Data(buffer[start..<offset]))
+      }
+      segments.append(payload)
+      start = offset
+    }
+    if buffer.count > start || segments.isEmpty {
+      segments.append(Data(buffer[start...]))
+    }
+    return segments
+  }
+}
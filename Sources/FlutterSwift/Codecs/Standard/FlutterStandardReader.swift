@@ -144,9 +144,29 @@ extension ParserSpan {
   @_lifetime(&self)
   #endif
   mutating func parseString() throws(ParsingError) -> String {
+    try parseString { String(validating: $0, as: UTF8.self) }
+  }
+
+  /// Reads a length-prefixed UTF-8 string through `interner`, which shares
+  /// the storage of strings it has seen before.
+  #if compiler(<6.3)
+  @_lifetime(&self)
+  #endif
+  mutating func parseString(
+    interning interner: FlutterStandardStringInterner
+  ) throws(ParsingError) -> String {
+    try parseString { interner.string(for: $0) }
+  }
+
+  #if compiler(<6.3)
+  @_lifetime(&self)
+  #endif
+  private mutating func parseString(
+    _ makeString: (UnsafeRawBufferPointer) -> String?
+  ) throws(ParsingError) -> String {
     let length = try parseSize()
     let slice = try sliceSpan(byteCount: length)
-    guard let value = slice.withUnsafeBytes({ String(validating: $0, as: UTF8.self) }) else {
+    guard let value = slice.withUnsafeBytes(makeString) else {
       let raw = slice.withUnsafeBytes { Data($0) }
       throw ParsingError(userError: FlutterSwiftError.stringNotDecodable(raw))
     }
@@ -166,6 +186,28 @@ extension ParserSpan {
   mutating func parseTypedArray<T: BitwiseCopyable>(
     of type: T.Type
   ) throws(ParsingError) -> [T] {
+    let (count, byteCount) = try parseTypedArrayHeader(of: type)
+    let slice = try sliceSpan(byteCount: byteCount)
+    return slice.withUnsafeBytes { source in
+      [T](unsafeUninitializedCapacity: count) { destination, initializedCount in
+        if count > 0 {
+          UnsafeMutableRawBufferPointer(destination).copyMemory(from: source)
+        }
+        initializedCount = count
+      }
+    }
+  }
+}
+
+extension ParserSpan {
+  /// Reads a typed-data array's element count and alignment padding, leaving
+  /// the cursor on the first element.
+  #if compiler(<6.3)
+  @_lifetime(&self)
+  #endif
+  mutating func parseTypedArrayHeader<T: BitwiseCopyable>(
+    of type: T.Type
+  ) throws(ParsingError) -> (count: Int, byteCount: Int) {
     let count = try parseSize()
     try parseAlignment(to: MemoryLayout<T>.stride)
     let (byteCount, overflow) = count.multipliedReportingOverflow(
@@ -174,15 +216,183 @@ extension ParserSpan {
     guard !overflow else {
       throw ParsingError(userError: FlutterSwiftError.variableSizedTypeTooBig)
     }
-    let slice = try sliceSpan(byteCount: byteCount)
-    return slice.withUnsafeBytes { source in
-      [T](unsafeUninitializedCapacity: count) { destination, initializedCount in
-        if count > 0 {
-          UnsafeMutableRawBufferPointer(destination).copyMemory(from: source)
+    return (count, byteCount)
+  }
+
+  /// Consumes one whole value, type tag included, without materializing it.
+  ///
+  /// Scalars, strings and typed data are passed over with a single seek past
+  /// their payload. Only lists and maps are walked, because their size prefix
+  /// counts elements rather than bytes; even then nothing is allocated.
+  #if compiler(<6.3)
+  @_lifetime(&self)
+  #endif
+  mutating func skipValue() throws(ParsingError) {
+    try skipPayload(of: FlutterStandardField(parsing: &self))
+  }
+
+  /// As `skipValue()`, for a value whose tag has already been read.
+  #if compiler(<6.3)
+  @_lifetime(&self)
+  #endif
+  mutating func skipPayload(of field: FlutterStandardField) throws(ParsingError) {
+    switch field {
+    case .nil, .true, .false:
+      break
+    case .int32:
+      try seek(toRelativeOffset: MemoryLayout<Int32>.size)
+    case .int64:
+      try seek(toRelativeOffset: MemoryLayout<Int64>.size)
+    case .float64:
+      try parseAlignment(to: MemoryLayout<Double>.alignment)
+      try seek(toRelativeOffset: MemoryLayout<Double>.size)
+    case .string, .uint8Data:
+      try seek(toRelativeOffset: parseSize())
+    case .int32Data:
+      try seek(toRelativeOffset: parseTypedArrayHeader(of: Int32.self).byteCount)
+    case .int64Data:
+      try seek(toRelativeOffset: parseTypedArrayHeader(of: Int64.self).byteCount)
+    case .float32Data:
+      try seek(toRelativeOffset: parseTypedArrayHeader(of: Float.self).byteCount)
+    case .float64Data:
+      try seek(toRelativeOffset: parseTypedArrayHeader(of: Double.self).byteCount)
+    case .list:
+      let count = try parseSize()
+      for _ in 0..<count {
+        try skipValue()
+      }
+    case .map:
+      let count = try parseSize()
+      for _ in 0..<count {
+        try skipValue()
+        try skipValue()
+      }
+    case .intHex:
+      throw ParsingError(userError: FlutterSwiftError.fieldNotDecodable)
+    }
+  }
+
+  /// Consumes one value and reports whether it is the string `key`.
+  ///
+  /// Compares the UTF-8 bytes in place, so probing a map's keys neither
+  /// allocates nor validates a `String` per entry. A key of any other type is
+  /// skipped and never matches.
+  #if compiler(<6.3)
+  @_lifetime(&self)
+  #endif
+  mutating func parseKey(matching key: String) throws(ParsingError) -> Bool {
+    let field = try FlutterStandardField(parsing: &self)
+    guard field == .string else {
+      try skipPayload(of: field)
+      return false
+    }
+    let length = try parseSize()
+    let slice = try sliceSpan(byteCount: length)
+    guard length == key.utf8.count else { return false }
+    return slice.withUnsafeBytes { $0.elementsEqual(key.utf8) }
+  }
+}
+
+extension ParserSpan {
+  /// Reads a list of strings as substrings of one shared `String`.
+  ///
+  /// Decoding each element as its own `String` allocates once per string that
+  /// is too long to be stored inline (more than 15 UTF-8 bytes), and validates
+  /// each one separately. Here the elements are copied back to back into one
+  /// scratch buffer and validated in a single pass, and the result is a
+  /// single allocation that every element shares.
+  ///
+  /// Validating the concatenation alone is not enough: an element ending in a
+  /// truncated sequence could be completed by the next element's leading
+  /// continuation bytes. Requiring every non-empty element to begin on a scalar
+  /// boundary closes that gap, because a truncated sequence followed by
+  /// anything but a continuation byte is itself invalid.
+  #if compiler(<6.3)
+  @_lifetime(&self)
+  #endif
+  mutating func parseStringList() throws(ParsingError) -> [Substring] {
+    try parseAssertedField(.list)
+    let count = try parseSize()
+    let origin = self
+    var elements = [(offset: Int, length: Int)]()
+    elements.reserveCapacity(count)
+    var totalLength = 0
+    for _ in 0..<count {
+      try parseAssertedField(.string)
+      let length = try parseSize()
+      elements.append((startPosition - origin.startPosition, length))
+      _ = try sliceSpan(byteCount: length)
+      totalLength += length
+    }
+
+    let (storage, raw) = origin.withUnsafeBytes { base -> (String?, Data?) in
+      var scratch = [UInt8]()
+      scratch.reserveCapacity(totalLength)
+      var startsOnBoundaries = true
+      for element in elements {
+        let bytes = UnsafeRawBufferPointer(rebasing: base[element.offset..<(element.offset + element.length)])
+        if let first = bytes.first, first & 0xC0 == 0x80 {
+          startsOnBoundaries = false
         }
-        initializedCount = count
+        scratch.append(contentsOf: bytes)
       }
+      if startsOnBoundaries, let storage = String(validating: scratch, as: UTF8.self) {
+        return (storage, nil)
+      }
+      // slow path, for the error only: report the first offending element
+      for element in elements {
+        let bytes = UnsafeRawBufferPointer(rebasing: base[element.offset..<(element.offset + element.length)])
+        if String(validating: bytes, as: UTF8.self) == nil {
+          return (nil, Data(bytes))
+        }
+      }
+      return (nil, Data(scratch))
+    }
+    guard let storage else {
+      throw ParsingError(userError: FlutterSwiftError.stringNotDecodable(raw ?? Data()))
+    }
+
+    var values = [Substring]()
+    values.reserveCapacity(count)
+    let utf8 = storage.utf8
+    var start = utf8.startIndex
+    for element in elements {
+      let end = utf8.index(start, offsetBy: element.length)
+      values.append(storage[start..<end])
+      start = end
+    }
+    return values
+  }
+
+  /// Consumes one map key and returns its hash, as `FlutterStandardMapIndex`
+  /// computes it for a lookup key.
+  ///
+  /// String keys hash their UTF-8 bytes in place and integer keys their value,
+  /// so neither is materialized. All other keys share one hash and are told
+  /// apart by comparison after the probe; they are rare enough in practice not
+  /// to be worth a canonical byte form.
+  #if compiler(<6.3)
+  @_lifetime(&self)
+  #endif
+  mutating func parseKeyHash() throws(ParsingError) -> Int {
+    let field = try FlutterStandardField(parsing: &self)
+    var hasher = Hasher()
+    switch field {
+    case .string:
+      hasher.combine(field)
+      let length = try parseSize()
+      let slice = try sliceSpan(byteCount: length)
+      slice.withUnsafeBytes { hasher.combine(bytes: $0) }
+    case .int32:
+      hasher.combine(field)
+      try hasher.combine(Int32(parsing: &self, endianness: .host))
+    case .int64:
+      hasher.combine(field)
+      try hasher.combine(Int64(parsing: &self, endianness: .host))
+    default:
+      try skipPayload(of: field)
     }
+    return hasher.finalize()
   }
 }
 
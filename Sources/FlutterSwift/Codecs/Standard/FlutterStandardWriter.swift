@@ -36,7 +36,9 @@ import Foundation
 /// Alignment padding is measured from the start of the *message*, so a
 /// conforming writer must begin at message offset zero: `writtenByteCount` is
 /// taken to be the number of bytes written so far in the current message, the
-/// way the readers key off `ParserSpan.startPosition`.
+/// way the readers key off `ParserSpan.startPosition`. (The one exception is
+/// `FlutterStandardByteCounter`, which starts part-way in to measure a value
+/// nested at that offset.)
 protocol FlutterStandardByteStreamWriter {
   var writtenByteCount: Int { get }
   mutating func writeByte(_ byte: UInt8)
@@ -81,6 +83,34 @@ extension Data: FlutterStandardByteStreamWriter {
   }
 }
 
+/// A writer that keeps nothing but the count, so that running the grammar into
+/// it measures a message exactly — alignment padding included — without a
+/// second implementation of the sizing rules to drift out of step with the real
+/// writers.
+struct FlutterStandardByteCounter: FlutterStandardByteStreamWriter {
+  private(set) var writtenByteCount: Int
+
+  /// `offset` is where in the message the measured value will start, since
+  /// that decides how much padding its aligned fields need.
+  init(startingAt offset: Int = 0) {
+    writtenByteCount = offset
+  }
+
+  mutating func writeByte(_ byte: UInt8) {
+    writtenByteCount += 1
+  }
+
+  mutating func writeBytes(_ bytes: UnsafeRawBufferPointer) {
+    writtenByteCount += bytes.count
+  }
+
+  mutating func writeZeros(count: Int) {
+    writtenByteCount += count
+  }
+
+  mutating func reserveCapacity(_ capacity: Int) {}
+}
+
 /// The codec's grammar, as methods on the writer itself.
 ///
 /// This follows the engine, where the primitives belong to the byte sink rather
@@ -161,6 +191,29 @@ extension FlutterStandardByteStreamWriter {
     value.withUnsafeBytes { writeBytes($0) }
   }
 
+  /// Writes everything of a typed-data value but its elements: the tag, the
+  /// element count and the padding that aligns the first element.
+  mutating func writeTypedDataHeader(
+    _ field: FlutterStandardField,
+    count: Int,
+    alignment: Int
+  ) throws(FlutterSwiftError) {
+    writeField(field)
+    try writeSize(count)
+    writeAlignment(alignment)
+  }
+
+  /// Writes typed data whose elements are already laid out in `bytes`, in
+  /// host byte order, `stride` bytes apiece.
+  mutating func writeTypedData(
+    _ field: FlutterStandardField,
+    _ bytes: UnsafeRawBufferPointer,
+    stride: Int
+  ) throws(FlutterSwiftError) {
+    try writeTypedDataHeader(field, count: bytes.count / stride, alignment: stride)
+    writeBytes(bytes)
+  }
+
   /// Bulk-writes a typed-data array in a single buffer append.
   ///
   /// The Flutter standard codec stores typed data (`Uint8List`, `Int32List`,
@@ -174,9 +227,7 @@ extension FlutterStandardByteStreamWriter {
     _ field: FlutterStandardField,
     _ value: [T]
   ) throws(FlutterSwiftError) {
-    writeField(field)
-    try writeSize(value.count)
-    writeAlignment(MemoryLayout<T>.stride)
+    try writeTypedDataHeader(field, count: value.count, alignment: MemoryLayout<T>.stride)
     value.withUnsafeBytes { writeBytes($0) }
   }
 }
@@ -29,8 +29,24 @@ import Foundation
  */
 public typealias FlutterBinaryMessageHandler = @Sendable (Data?) async throws -> Data?
 
+/**
+ * A strategy for decoding a reply from Flutter in place.
+ *
+ * `reply` is only valid for the duration of the call — on eLinux it is the
+ * engine's own buffer, freed as soon as the reply callback returns — so the
+ * decoded value must not reference it.
+ *
+ * @param reply The reply, or `nil` if it is empty.
+ * @result The decoded reply.
+ */
+public typealias FlutterBinaryReplyDecoder<Reply> =
+  @Sendable (UnsafeRawBufferPointer?) throws -> Reply
+
 public typealias FlutterBinaryMessengerConnection = Int64
 
+/// A message addressed to a channel, as an element of a batched send.
+public typealias FlutterBinaryMessage = (channel: String, message: Data?)
+
 #if canImport(Android)
 import AndroidLooper
 
@@ -72,13 +88,114 @@ public protocol FlutterBinaryMessenger: Sendable {
   @FlutterPlatformThreadActor
   func send(on channel: String, message: Data?, priority: TaskPriority?) async throws -> Data?
 
+  @FlutterPlatformThreadActor
+  func send<Reply: Sendable>(
+    on channel: String,
+    message: Data?,
+    priority: TaskPriority?,
+    decodingReply decode: @escaping FlutterBinaryReplyDecoder<Reply>
+  ) async throws -> Reply
+
+  /// Sends each message in order, in one turn of the platform thread, without
+  /// waiting for replies. A failed send does not stop the rest of the batch;
+  /// the result at each index reports the message at that index.
+  @FlutterPlatformThreadActor
+  func send(batch: [FlutterBinaryMessage]) -> [Result<(), Error>]
+
+  /// Sends the concatenation of `segments` as one message, without waiting
+  /// for a reply — as from `FlutterStandardMessageCodec.encodeSegments(_:)`,
+  /// whose large payloads stay in their own storage until they are gathered
+  /// here. This saves the encoder's copies, not the messenger's: the segments
+  /// are still gathered into one buffer, which the engine copies again.
+  @FlutterPlatformThreadActor
+  func send(on channel: String, segments: [Data]) throws
+
   func setMessageHandler(
     on channel: String,
     handler: FlutterBinaryMessageHandler?,
     priority: TaskPriority?
   ) throws -> FlutterBinaryMessengerConnection
 
+  /// Registers `handler`, run for each message as `dispatch` says.
+  func setMessageHandler(
+    on channel: String,
+    handler: FlutterBinaryMessageHandler?,
+    priority: TaskPriority?,
+    dispatch: FlutterMessageDispatch
+  ) throws -> FlutterBinaryMessengerConnection
+
   func cleanUp(connection: FlutterBinaryMessengerConnection) throws
+
+  /// Where the messenger and the channels using it record their metrics, or
+  /// `nil` if they do not. Once set, it does not change: channels keep the
+  /// metrics they find there.
+  var instrumentation: FlutterChannelInstrumentation? { get }
+}
+
+public extension FlutterBinaryMessenger {
+  var instrumentation: FlutterChannelInstrumentation? { nil }
+
+  /// Messengers that run every handler on a task of its own ignore `dispatch`.
+  func setMessageHandler(
+    on channel: String,
+    handler: FlutterBinaryMessageHandler?,
+    priority: TaskPriority?,
+    dispatch: FlutterMessageDispatch
+  ) throws -> FlutterBinaryMessengerConnection {
+    try setMessageHandler(on: channel, handler: handler, priority: priority)
+  }
+
+  /// Messengers that cannot lend out the reply buffer decode from a copy.
+  @FlutterPlatformThreadActor
+  func send<Reply: Sendable>(
+    on channel: String,
+    message: Data?,
+    priority: TaskPriority?,
+    decodingReply decode: @escaping FlutterBinaryReplyDecoder<Reply>
+  ) async throws -> Reply {
+    let reply = try await send(on: channel, message: message, priority: priority)
+    guard let reply, !reply.isEmpty else { return try decode(nil) }
+    return try reply.withUnsafeBytes { try decode($0) }
+  }
+
+  @FlutterPlatformThreadActor
+  func send(batch: [FlutterBinaryMessage]) -> [Result<(), Error>] {
+    batch.map { message in
+      Result { try send(on: message.channel, message: message.message) }
+    }
+  }
+
+  /// Messengers that cannot gather segments themselves send a concatenation.
+  @FlutterPlatformThreadActor
+  func send(on channel: String, segments: [Data]) throws {
+    switch segments.count {
+    case 0:
+      try send(on: channel, message: nil)
+    case 1:
+      try send(on: channel, message: segments[0])
+    default:
+      var message = Data(capacity: segments.reduce(0) { $0 + $1.count })
+      for segment in segments {
+        message.append(segment)
+      }
+      try send(on: channel, message: message)
+    }
+  }
+
+  /// Sends `message` and decodes the reply with `codec`, in place where the
+  /// messenger allows. Returns `nil` for an empty reply.
+  @FlutterPlatformThreadActor
+  func send<Reply: Decodable & Sendable>(
+    on channel: String,
+    message: Data?,
+    priority: TaskPriority?,
+    codec: FlutterMessageCodec,
+    reply type: Reply.Type = Reply.self
+  ) async throws -> Reply? {
+    try await send(on: channel, message: message, priority: priority) { reply in
+      try reply.map { try codec.decode(borrowing: $0) as Reply }
+    }
+  }
 }
 
 extension FlutterBinaryMessenger {
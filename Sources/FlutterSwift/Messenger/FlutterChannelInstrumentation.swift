@@ -0,0 +1,383 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Atomics
+import Synchronization
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/// The stages of a message's life that `FlutterChannelInstrumentation` times.
+public enum FlutterChannelPhase: String, CaseIterable, Sendable {
+  /// From the engine's callback to the start of the task running the handler.
+  case queue
+  /// The handler itself, including decoding the message and encoding the reply.
+  case handler
+  /// From sending a message to receiving its reply.
+  case response
+  /// Encoding a message or reply with the channel's codec.
+  case encode
+  /// Decoding a message or reply with the channel's codec.
+  case decode
+}
+
+/**
+ * A log2-bucketed histogram of durations, recorded without locks.
+ *
+ * Bucket `i` counts durations of `[2^i, 2^(i+1))` nanoseconds, so percentiles
+ * are reported to within a factor of two: coarse, but enough to see where a
+ * message's time goes, and cheap enough — one atomic increment per bucket,
+ * count and sum — to leave on in production.
+ */
+public final class FlutterLatencyHistogram: Sendable {
+  public struct Snapshot: Sendable {
+    /// The count in each bucket; see `FlutterLatencyHistogram`.
+    public let buckets: [Int]
+    public let count: Int
+    public let total: Duration
+
+    public var mean: Duration {
+      count > 0 ? total / count : .zero
+    }
+
+    /// The upper bound of the bucket holding the `percentile`th duration.
+    public func percentile(_ percentile: Double) -> Duration {
+      guard count > 0 else { return .zero }
+      let rank = max(Int((percentile / 100 * Double(count)).rounded(.up)), 1)
+      var seen = 0
+      for (bucket, bucketCount) in buckets.enumerated() {
+        seen += bucketCount
+        if seen >= rank {
+          return .nanoseconds(bucket < 62 ? 1 << (bucket + 1) : Int64.max)
+        }
+      }
+      return .nanoseconds(Int64.max)
+    }
+  }
+
+  static let bucketCount = 64
+
+  private let buckets = (0..<FlutterLatencyHistogram.bucketCount).map { _ in ManagedAtomic<Int>(0) }
+  private let count = ManagedAtomic<Int>(0)
+  private let totalNanoseconds = ManagedAtomic<Int>(0)
+
+  init() {}
+
+  func record(_ duration: Duration) {
+    let (seconds, attoseconds) = duration.components
+    let nanoseconds = max(Int(seconds) &* 1_000_000_000 &+ Int(attoseconds / 1_000_000_000), 0)
+    let bucket = nanoseconds > 0 ? Int.bitWidth - 1 - nanoseconds.leadingZeroBitCount : 0
+    buckets[bucket].wrappingIncrement(ordering: .relaxed)
+    count.wrappingIncrement(ordering: .relaxed)
+    totalNanoseconds.wrappingIncrement(by: nanoseconds, ordering: .relaxed)
+  }
+
+  func reset() {
+    for bucket in buckets {
+      bucket.store(0, ordering: .relaxed)
+    }
+    count.store(0, ordering: .relaxed)
+    totalNanoseconds.store(0, ordering: .relaxed)
+  }
+
+  /// The histogram as it stands. Taken bucket by bucket while recording may
+  /// continue, so its count can be a few recordings off its buckets' sum.
+  public func snapshot() -> Snapshot {
+    Snapshot(
+      buckets: buckets.map { $0.load(ordering: .relaxed) },
+      count: count.load(ordering: .relaxed),
+      total: .nanoseconds(totalNanoseconds.load(ordering: .relaxed))
+    )
+  }
+}
+
+/// What `FlutterChannelInstrumentation` has recorded for one channel.
+public final class FlutterChannelMetrics: Sendable {
+  public struct Snapshot: Sendable {
+    public let name: String
+    public let messagesReceived: Int
+    public let bytesReceived: Int
+    public let messagesSent: Int
+    public let bytesSent: Int
+    public let latencies: [FlutterChannelPhase: FlutterLatencyHistogram.Snapshot]
+  }
+
+  public let name: String
+
+  private let messagesReceived = ManagedAtomic<Int>(0)
+  private let bytesReceived = ManagedAtomic<Int>(0)
+  private let messagesSent = ManagedAtomic<Int>(0)
+  private let bytesSent = ManagedAtomic<Int>(0)
+  private let histograms: [FlutterChannelPhase: FlutterLatencyHistogram]
+
+  init(name: String) {
+    self.name = name
+    histograms = Dictionary(uniqueKeysWithValues: FlutterChannelPhase.allCases.map {
+      ($0, FlutterLatencyHistogram())
+    })
+  }
+
+  public func latency(_ phase: FlutterChannelPhase) -> FlutterLatencyHistogram {
+    histograms[phase]!
+  }
+
+  func recordReceived(byteCount: Int) {
+    messagesReceived.wrappingIncrement(ordering: .relaxed)
+    bytesReceived.wrappingIncrement(by: byteCount, ordering: .relaxed)
+  }
+
+  func recordSent(byteCount: Int) {
+    messagesSent.wrappingIncrement(ordering: .relaxed)
+    bytesSent.wrappingIncrement(by: byteCount, ordering: .relaxed)
+  }
+
+  func reset() {
+    for counter in [messagesReceived, bytesReceived, messagesSent, bytesSent] {
+      counter.store(0, ordering: .relaxed)
+    }
+    for histogram in histograms.values {
+      histogram.reset()
+    }
+  }
+
+  public func snapshot() -> Snapshot {
+    Snapshot(
+      name: name,
+      messagesReceived: messagesReceived.load(ordering: .relaxed),
+      bytesReceived: bytesReceived.load(ordering: .relaxed),
+      messagesSent: messagesSent.load(ordering: .relaxed),
+      bytesSent: bytesSent.load(ordering: .relaxed),
+      latencies: histograms.mapValues { $0.snapshot() }
+    )
+  }
+}
+
+/**
+ * Per-channel counts, byte totals and latency histograms, for a messenger and
+ * the channels using it.
+ *
+ * Set a messenger's `instrumentation` to start recording. The messenger counts
+ * what it sends and receives and times the queue, handler and response
+ * phases; the basic, method and event channels time their encoding and
+ * decoding. Read the results with `snapshot()` whenever convenient.
+ *
+ * Recording takes no locks. A channel's metrics are looked up under a lock
+ * once, on the channel's first message, and kept by the channel and by the
+ * messenger's registration of its handler; sending on a channel by name,
+ * through the messenger alone, looks them up once per message.
+ *
+ * For a timeline of individual messages, `startTracing(maximumEventCount:)`
+ * also records each phase as an event, which `stopTracing()` returns in the
+ * Chrome trace event format that Perfetto (ui.perfetto.dev) and
+ * `chrome://tracing` open, one track per channel.
+ */
+public final class FlutterChannelInstrumentation: Sendable {
+  private struct TraceEvent {
+    let phase: FlutterChannelPhase
+    let channel: String
+    let start: Duration
+    let duration: Duration
+  }
+
+  private struct Trace {
+    let origin: ContinuousClock.Instant
+    let maximumEventCount: Int
+    var events = [TraceEvent]()
+  }
+
+  private let metrics = Mutex<[String: FlutterChannelMetrics]>([:])
+  private let isTracing = ManagedAtomic<Bool>(false)
+  private let trace = Mutex<Trace?>(nil)
+
+  public init() {}
+
+  /// The metrics for `channel`, created on first use.
+  public func metrics(for channel: String) -> FlutterChannelMetrics {
+    metrics.withLock { metrics in
+      if let channelMetrics = metrics[channel] {
+        return channelMetrics
+      }
+      let channelMetrics = FlutterChannelMetrics(name: channel)
+      metrics[channel] = channelMetrics
+      return channelMetrics
+    }
+  }
+
+  /// Every channel's metrics, as they stand.
+  public func snapshot() -> [String: FlutterChannelMetrics.Snapshot] {
+    metrics.withLock { $0 }.mapValues { $0.snapshot() }
+  }
+
+  /// Zeroes every channel's metrics. The channels are kept, as their
+  /// messengers and channels hold on to them.
+  public func reset() {
+    for channelMetrics in metrics.withLock({ Array($0.values) }) {
+      channelMetrics.reset()
+    }
+  }
+
+  func record(
+    _ phase: FlutterChannelPhase,
+    in channelMetrics: FlutterChannelMetrics,
+    from start: ContinuousClock.Instant,
+    to end: ContinuousClock.Instant = .now
+  ) {
+    let duration = start.duration(to: end)
+    channelMetrics.latency(phase).record(duration)
+    guard isTracing.load(ordering: .relaxed) else { return }
+    trace.withLock { trace in
+      guard var current = trace, current.events.count < current.maximumEventCount else { return }
+      trace = nil
+      current.events.append(TraceEvent(
+        phase: phase,
+        channel: channelMetrics.name,
+        start: current.origin.duration(to: start),
+        duration: duration
+      ))
+      trace = current
+    }
+  }
+
+  // MARK: - tracing
+
+  /// Starts recording each phase as a trace event, discarding any trace in
+  /// progress. Events past `maximumEventCount` are dropped, bounding memory.
+  public func startTracing(maximumEventCount: Int = 100_000) {
+    trace.withLock {
+      $0 = Trace(origin: .now, maximumEventCount: maximumEventCount)
+    }
+    isTracing.store(true, ordering: .relaxed)
+  }
+
+  /// Stops tracing, returning the trace as Chrome trace event JSON, or `nil`
+  /// if no trace was in progress.
+  public func stopTracing() throws -> Data? {
+    isTracing.store(false, ordering: .relaxed)
+    guard let trace = trace.withLock({ trace in
+      defer { trace = nil }
+      return trace
+    }) else {
+      return nil
+    }
+    return try JSONEncoder().encode(ChromeTrace(trace.events))
+  }
+
+  /// https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+  private struct ChromeTrace: Encodable {
+    struct Event: Encodable {
+      let name: String
+      let cat: String
+      let ph: String
+      let ts: Double?
+      let dur: Double?
+      let pid: Int
+      let tid: Int
+      let args: [String: String]?
+    }
+
+    let traceEvents: [Event]
+    let displayTimeUnit: String
+
+    init(_ events: [TraceEvent]) {
+      func microseconds(_ duration: Duration) -> Double {
+        let (seconds, attoseconds) = duration.components
+        return Double(seconds) * 1e6 + Double(attoseconds) * 1e-12
+      }
+
+      var tracks = [String: Int]()
+      var traceEvents = [Event]()
+      for event in events {
+        let tid: Int
+        if let track = tracks[event.channel] {
+          tid = track
+        } else {
+          tid = tracks.count + 1
+          tracks[event.channel] = tid
+          // names the channel's track
+          traceEvents.append(Event(
+            name: "thread_name",
+            cat: "__metadata",
+            ph: "M",
+            ts: nil,
+            dur: nil,
+            pid: 1,
+            tid: tid,
+            args: ["name": event.channel]
+          ))
+        }
+        traceEvents.append(Event(
+          name: event.phase.rawValue,
+          cat: "channel",
+          ph: "X",
+          ts: microseconds(event.start),
+          dur: microseconds(event.duration),
+          pid: 1,
+          tid: tid,
+          args: nil
+        ))
+      }
+      self.traceEvents = traceEvents
+      displayTimeUnit = "ns"
+    }
+  }
+}
+
+/// A channel's `FlutterChannelMetrics`, looked up in its messenger's
+/// instrumentation on first use and kept, so that recording takes no lock.
+/// A messenger's instrumentation is set at most once, so the cache never needs
+/// invalidating.
+final class _FlutterChannelMetricsCache: Sendable {
+  let channel: String
+  private let metrics = ManagedAtomicLazyReference<FlutterChannelMetrics>()
+
+  init(channel: String) {
+    self.channel = channel
+  }
+
+  func metrics(in instrumentation: FlutterChannelInstrumentation) -> FlutterChannelMetrics {
+    metrics.load() ?? metrics.storeIfNilThenLoad(instrumentation.metrics(for: channel))
+  }
+
+  func recordReceived(in instrumentation: FlutterChannelInstrumentation?, byteCount: Int) {
+    guard let instrumentation else { return }
+    metrics(in: instrumentation).recordReceived(byteCount: byteCount)
+  }
+
+  func record(
+    _ phase: FlutterChannelPhase,
+    in instrumentation: FlutterChannelInstrumentation?,
+    from start: ContinuousClock.Instant,
+    to end: ContinuousClock.Instant = .now
+  ) {
+    guard let instrumentation else { return }
+    instrumentation.record(phase, in: metrics(in: instrumentation), from: start, to: end)
+  }
+
+  /// Times `body` as `phase`, if `binaryMessenger` is instrumented.
+  func measure<Value>(
+    _ phase: FlutterChannelPhase,
+    with binaryMessenger: FlutterBinaryMessenger,
+    _ body: () throws -> Value
+  ) rethrows -> Value {
+    let instrumentation = binaryMessenger.instrumentation
+    guard instrumentation != nil else { return try body() }
+    let start = ContinuousClock.now
+    defer { record(phase, in: instrumentation, from: start) }
+    return try body()
+  }
+}
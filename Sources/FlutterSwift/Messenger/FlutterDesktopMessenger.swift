@@ -25,11 +25,48 @@ import FoundationEssentials
 import Foundation
 #endif
 
+/**
+ * A strategy for handling incoming binary messages without first copying them
+ * out of the engine.
+ *
+ * `message` views the engine's own buffer, which stays alive until the reply is
+ * sent via `FlutterDesktopMessengerSendResponse`. That happens once the handler
+ * returns, so the view is valid for exactly the handler's duration and must not
+ * escape it; decode from it in place, e.g. with `FlutterMessageCodec.decode(borrowing:)`.
+ *
+ * @param message The message, or `nil` if it is empty.
+ * @result The reply to send back to Flutter.
+ */
+public typealias FlutterBorrowingBinaryMessageHandler =
+  @Sendable (UnsafeRawBufferPointer?) async throws -> Data?
+
 public final class FlutterDesktopMessenger: FlutterBinaryMessenger, @unchecked Sendable {
   private let currentMessengerConnection = ManagedAtomic<FlutterBinaryMessengerConnection>(0)
-  // connection -> channel, so cleanUp(connection:) can unregister the callback
-  private let handlerChannels = Mutex<[FlutterBinaryMessengerConnection: String]>([:])
+  // connection -> channel, so cleanUp(connection:) can unregister the callback,
+  // and the queue running the channel's handlers if its dispatch is serial
+  private let handlerChannels =
+    Mutex<[FlutterBinaryMessengerConnection: (channel: String, queue: _FlutterMessageQueue?)]>([:])
   private let messenger: FlutterDesktopMessengerRef
+  private let _instrumentation = ManagedAtomicLazyReference<FlutterChannelInstrumentation>()
+  private let _scheduler = Mutex<FlutterMessageScheduler?>(nil)
+
+  /// Where this messenger, and the channels using it, record their metrics.
+  /// Off by default, and set at most once: to start afresh, `reset()` it.
+  public var instrumentation: FlutterChannelInstrumentation? {
+    get { _instrumentation.load() }
+    set {
+      guard let newValue else { preconditionFailure("instrumentation cannot be removed") }
+      let instrumentation = _instrumentation.storeIfNilThenLoad(newValue)
+      precondition(instrumentation === newValue, "instrumentation is already set")
+    }
+  }
+
+  /// Admits this messenger's incoming messages by their channels' classes, or
+  /// `nil` to start each handler as soon as its message arrives.
+  public var scheduler: FlutterMessageScheduler? {
+    get { _scheduler.withLock { $0 } }
+    set { _scheduler.withLock { $0 = newValue } }
+  }
 
   // : - Initializers
 
@@ -74,21 +111,64 @@ public final class FlutterDesktopMessenger: FlutterBinaryMessenger, @unchecked S
     message: Data?,
     _ block: FlutterDesktopBinaryReplyBlock?
   ) throws {
-    guard try (message ?? Data()).withUnsafeBytes({ bytes in
-      try withMessenger { messenger in
-        FlutterDesktopMessengerSendWithReplyBlock(
-          messenger,
-          channel,
-          bytes.count > 0 ? bytes.baseAddress : nil,
-          bytes.count,
-          block
-        )
-      }
+    try withMessenger { messenger in
+      try send(on: channel, message: message, block, messenger: messenger)
+    }
+  }
+
+  /// The send itself, for callers already holding the messenger lock.
+  @FlutterPlatformThreadActor
+  private func send(
+    on channel: String,
+    message: Data?,
+    _ block: FlutterDesktopBinaryReplyBlock?,
+    messenger: FlutterDesktopMessengerRef
+  ) throws {
+    guard (message ?? Data()).withUnsafeBytes({ bytes in
+      FlutterDesktopMessengerSendWithReplyBlock(
+        messenger,
+        channel,
+        bytes.count > 0 ? bytes.baseAddress : nil,
+        bytes.count,
+        block
+      )
     }) == true else {
       throw FlutterSwiftError.messageSendFailure
     }
   }
 
+  /// Gathers `segments` into the engine's send, keeping each one's bytes
+  /// alive for the duration of the call.
+  @FlutterPlatformThreadActor
+  private func send(
+    on channel: String,
+    segments: ArraySlice<Data>,
+    gathered: inout [FlutterDesktopMessageSegment],
+    messenger: FlutterDesktopMessengerRef
+  ) -> Bool {
+    guard let segment = segments.first else {
+      return FlutterDesktopMessengerSendSegmentsWithReplyBlock(
+        messenger,
+        channel,
+        gathered,
+        gathered.count,
+        nil
+      )
+    }
+    return segment.withUnsafeBytes { bytes in
+      gathered.append(FlutterDesktopMessageSegment(
+        data: bytes.count > 0 ? bytes.baseAddress?.assumingMemoryBound(to: UInt8.self) : nil,
+        size: bytes.count
+      ))
+      return send(
+        on: channel,
+        segments: segments.dropFirst(),
+        gathered: &gathered,
+        messenger: messenger
+      )
+    }
+  }
+
   private func setCallbackBlock(
     on channel: String,
     _ block: FlutterDesktopMessageCallbackBlock?
@@ -132,20 +212,36 @@ public final class FlutterDesktopMessenger: FlutterBinaryMessenger, @unchecked S
     message: Data?,
     priority: TaskPriority?
   ) async throws -> Data? {
-    try await withPriority(priority) {
+    try await send(on: channel, message: message, priority: priority) { reply in
+      // copy: the engine-owned reply buffer is freed after the reply callback
+      reply.map { Data($0) }
+    }
+  }
+
+  /// Decodes the reply inside the engine's reply callback, while its buffer is
+  /// still alive, so only the decoded value has to outlive it.
+  @FlutterPlatformThreadActor
+  public func send<Reply: Sendable>(
+    on channel: String,
+    message: Data?,
+    priority: TaskPriority?,
+    decodingReply decode: @escaping FlutterBinaryReplyDecoder<Reply>
+  ) async throws -> Reply {
+    let instrumentation = instrumentation
+    let metrics = instrumentation?.metrics(for: channel)
+    metrics?.recordSent(byteCount: message?.count ?? 0)
+    let sent = ContinuousClock.now
+    return try await withPriority(priority) {
       try await withUnsafeThrowingContinuation { continuation in
         let replyThunk: FlutterDesktopBinaryReplyBlock?
 
         replyThunk = { bytes, count in
-          let data: Data?
-
-          if let bytes, count > 0 {
-            // copy: the engine-owned reply buffer is freed after this callback
-            data = Data(bytes: bytes, count: count)
-          } else {
-            data = nil
+          if let instrumentation, let metrics {
+            instrumentation.record(.response, in: metrics, from: sent)
           }
-          continuation.resume(returning: data)
+          let reply = bytes != nil && count > 0 ?
+            UnsafeRawBufferPointer(start: bytes, count: count) : nil
+          continuation.resume(with: Result { try decode(reply) })
         }
 
         Task {
@@ -162,45 +258,147 @@ public final class FlutterDesktopMessenger: FlutterBinaryMessenger, @unchecked S
 
   @FlutterPlatformThreadActor
   public func send(on channel: String, message: Data?) throws {
+    instrumentation?.metrics(for: channel).recordSent(byteCount: message?.count ?? 0)
     try send(on: channel, message: message, nil)
   }
 
+  /// Gathers the segments straight into one send, rather than concatenating
+  /// them into a `Data` first. The message is copied twice, once as the
+  /// segments are gathered and once into the engine's own allocation: the
+  /// same as concatenating them, less the allocation of the `Data`.
+  @FlutterPlatformThreadActor
+  public func send(on channel: String, segments: [Data]) throws {
+    instrumentation?.metrics(for: channel)
+      .recordSent(byteCount: segments.reduce(0) { $0 + $1.count })
+    let sent = try withMessenger { messenger in
+      var gathered = [FlutterDesktopMessageSegment]()
+      gathered.reserveCapacity(segments.count)
+      return send(on: channel, segments: segments[...], gathered: &gathered, messenger: messenger)
+    }
+    guard sent else {
+      throw FlutterSwiftError.messageSendFailure
+    }
+  }
+
+  /// Sends the whole batch under a single acquisition of the messenger lock.
+  @FlutterPlatformThreadActor
+  public func send(batch: [FlutterBinaryMessage]) -> [Result<(), Error>] {
+    if let instrumentation {
+      for message in batch {
+        instrumentation.metrics(for: message.channel)
+          .recordSent(byteCount: message.message?.count ?? 0)
+      }
+    }
+    do {
+      return try withMessenger { messenger in
+        batch.map { message in
+          Result {
+            try send(on: message.channel, message: message.message, nil, messenger: messenger)
+          }
+        }
+      }
+    } catch {
+      // the engine has gone away, so none of the batch was sent
+      return batch.map { _ in .failure(error) }
+    }
+  }
+
   public func setMessageHandler(
     on channel: String,
     handler: FlutterBinaryMessageHandler?,
     priority: TaskPriority?
+  ) throws -> FlutterBinaryMessengerConnection {
+    try setMessageHandler(on: channel, handler: handler, priority: priority, dispatch: .concurrent)
+  }
+
+  public func setMessageHandler(
+    on channel: String,
+    handler: FlutterBinaryMessageHandler?,
+    priority: TaskPriority?,
+    dispatch: FlutterMessageDispatch
+  ) throws -> FlutterBinaryMessengerConnection {
+    let borrowingHandler: FlutterBorrowingBinaryMessageHandler? = handler.map { handler in
+      { message in
+        // copy: a `FlutterBinaryMessageHandler` may keep the message past its reply
+        try await handler(message.map { Data($0) })
+      }
+    }
+    return try setMessageHandler(
+      on: channel,
+      borrowingHandler: borrowingHandler,
+      priority: priority,
+      dispatch: dispatch
+    )
+  }
+
+  /// Drops the registrations for `channel`, returning their queues to finish.
+  private func removeRegistrations(on channel: String) -> [_FlutterMessageQueue] {
+    handlerChannels.withLock { registry in
+      var queues = [_FlutterMessageQueue]()
+      for (staleConnection, registration) in registry where registration.channel == channel {
+        registry[staleConnection] = nil
+        if let queue = registration.queue { queues.append(queue) }
+      }
+      return queues
+    }
+  }
+
+  /// Registers a handler that reads incoming messages in place, from the
+  /// engine-owned buffer, rather than from a copy. See
+  /// `FlutterBorrowingBinaryMessageHandler` for how long the buffer is valid.
+  public func setMessageHandler(
+    on channel: String,
+    borrowingHandler handler: FlutterBorrowingBinaryMessageHandler?,
+    priority: TaskPriority?,
+    dispatch: FlutterMessageDispatch = .concurrent
   ) throws -> FlutterBinaryMessengerConnection {
     var connection: FlutterBinaryMessengerConnection = 0
+    // drop any stale mapping for this channel from a prior registration; its
+    // queue drains what it holds once the callback below no longer feeds it
+    let staleQueues = removeRegistrations(on: channel)
+    defer {
+      for queue in staleQueues {
+        queue.finish()
+      }
+    }
 
     if let handler {
       connection = currentMessengerConnection.wrappingIncrementThenLoad(by: 1, ordering: .relaxed)
-      handlerChannels.withLock { registry in
-        // drop any stale mapping for this channel from a prior registration
-        for (staleConnection, staleChannel) in registry where staleChannel == channel {
-          registry[staleConnection] = nil
+      let queue = _FlutterMessageQueue(dispatch, priority: priority)
+      let metrics = _FlutterChannelMetricsCache(channel: channel)
+      handlerChannels.withLock { $0[connection] = (channel, queue) }
+      var isRegistered = false
+      defer {
+        // a callback that failed to register will neither feed the queue nor
+        // be cleaned up, so undo the mapping here
+        if !isRegistered {
+          handlerChannels.withLock { _ = $0.removeValue(forKey: connection) }
+          queue?.finish()
         }
-        registry[connection] = channel
       }
 
       try setCallbackBlock(on: channel) { [weak self] _, message in
         let message = message.pointee
-        var messageData: Data?
 
         guard let self else {
           return
         }
 
-        if message.message_size > 0 {
-          let ptr = UnsafeRawPointer(message.message).bindMemory(
-            to: UInt8.self, capacity: message.message_size
-          )
-          messageData = Data(bytes: ptr, count: message.message_size)
-        }
+        let received = ContinuousClock.now
+        let instrumentation = self.instrumentation
+        metrics.recordReceived(in: instrumentation, byteCount: message.message_size)
 
+        // No copy: the response handle owns the message buffer, so it stays
+        // valid until sendResponse() below, which always runs after the handler.
+        nonisolated(unsafe) let messageBytes = message.message_size > 0 ?
+          UnsafeRawBufferPointer(start: message.message, count: message.message_size) : nil
         nonisolated(unsafe) let responseHandle = message.response_handle
-        let _ = Task(priority: priority) { @Sendable [self, handler, channel, messageData] in
+        let job: _FlutterMessageQueue.Job = { @Sendable [self, handler, channel] in
+          let started = ContinuousClock.now
+          metrics.record(.queue, in: instrumentation, from: received, to: started)
+          defer { metrics.record(.handler, in: instrumentation, from: started) }
           do {
-            let response = try await handler(messageData)
+            let response = try await handler(messageBytes)
             try? self.sendResponse(
               on: channel,
               handle: responseHandle,
@@ -212,15 +410,17 @@ public final class FlutterDesktopMessenger: FlutterBinaryMessenger, @unchecked S
             try? self.sendResponse(on: channel, handle: responseHandle, response: nil)
           }
         }
+        _dispatchMessage(
+          job,
+          on: channel,
+          priority: priority,
+          queue: queue,
+          scheduler: self.scheduler
+        )
       }
-
+      isRegistered = true
     } else {
       connection = 0
-      handlerChannels.withLock { registry in
-        for (staleConnection, staleChannel) in registry where staleChannel == channel {
-          registry[staleConnection] = nil
-        }
-      }
       try setCallbackBlock(on: channel, nil)
     }
 
@@ -228,11 +428,12 @@ public final class FlutterDesktopMessenger: FlutterBinaryMessenger, @unchecked S
   }
 
   public func cleanUp(connection: FlutterBinaryMessengerConnection) throws {
-    guard let channel = handlerChannels.withLock({ $0.removeValue(forKey: connection) })
+    guard let registration = handlerChannels.withLock({ $0.removeValue(forKey: connection) })
     else {
       return
     }
-    try setCallbackBlock(on: channel, nil)
+    defer { registration.queue?.finish() }
+    try setCallbackBlock(on: registration.channel, nil)
   }
 }
 #endif
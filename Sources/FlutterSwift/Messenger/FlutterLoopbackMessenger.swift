@@ -0,0 +1,296 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Atomics
+import Synchronization
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/**
+ * A messenger that delivers messages within the process, with no engine.
+ *
+ * A message sent on a channel is handed to the handler registered for that
+ * channel on the same messenger, dispatched as `FlutterDesktopMessenger`
+ * would, and the handler's reply is the sender's reply. A channel on one side
+ * and a channel of the same name on the other therefore talk to each other as
+ * they would through Flutter, and `FlutterMethodChannel`,
+ * `FlutterBasicMessageChannel` and `FlutterEventChannel` can be exercised, or
+ * loaded, without an engine or a display.
+ *
+ * Like the framework's `ChannelBuffers`, a message for a channel with no
+ * handler is held until one is registered, and then delivered, in order. Each
+ * channel holds `defaultBufferSize` messages unless resized; past that, the
+ * oldest is discarded and its sender replied to with `nil`. The
+ * `dev.flutter/channel-buffers` control messages that `resizeChannelBuffer(_:)`
+ * and `allowChannelBufferOverflow(_:)` send are honoured.
+ */
+public final class FlutterLoopbackMessenger: FlutterBinaryMessenger, Sendable {
+  /// The framework's default, `ChannelBuffers.kDefaultBufferSize`.
+  public static let defaultBufferSize = 1
+
+  private typealias Reply = @Sendable (Data?) -> ()
+
+  private struct Registration {
+    let connection: FlutterBinaryMessengerConnection
+    let handler: FlutterBinaryMessageHandler
+    let priority: TaskPriority?
+    let queue: _FlutterMessageQueue?
+    let metrics: _FlutterChannelMetricsCache
+  }
+
+  private struct ChannelBuffer {
+    var capacity = FlutterLoopbackMessenger.defaultBufferSize
+    var allowsOverflow = false
+    var pending = [(message: Data?, received: ContinuousClock.Instant, reply: Reply?)]()
+
+    /// Drops the oldest messages until the buffer is within its capacity, and
+    /// returns their reply callbacks.
+    mutating func discardExcess() -> [Reply?] {
+      let excess = max(pending.count - capacity, 0)
+      defer { pending.removeFirst(excess) }
+      return pending.prefix(excess).map(\.reply)
+    }
+  }
+
+  private struct State {
+    var registrations = [String: Registration]()
+    var buffers = [String: ChannelBuffer]()
+    var discardedMessageCount = 0
+  }
+
+  private let state = Mutex(State())
+  private let lastConnection = ManagedAtomic<FlutterBinaryMessengerConnection>(0)
+  private let _instrumentation = ManagedAtomicLazyReference<FlutterChannelInstrumentation>()
+  private let _scheduler = Mutex<FlutterMessageScheduler?>(nil)
+
+  public init() {}
+
+  /// Where this messenger, and the channels using it, record their metrics.
+  /// Off by default, and set at most once: to start afresh, `reset()` it. A
+  /// message's queue time includes any time it spent buffered, awaiting a
+  /// handler.
+  public var instrumentation: FlutterChannelInstrumentation? {
+    get { _instrumentation.load() }
+    set {
+      guard let newValue else { preconditionFailure("instrumentation cannot be removed") }
+      let instrumentation = _instrumentation.storeIfNilThenLoad(newValue)
+      precondition(instrumentation === newValue, "instrumentation is already set")
+    }
+  }
+
+  /// Admits this messenger's incoming messages by their channels' classes, or
+  /// `nil` to start each handler as soon as its message arrives.
+  public var scheduler: FlutterMessageScheduler? {
+    get { _scheduler.withLock { $0 } }
+    set { _scheduler.withLock { $0 = newValue } }
+  }
+
+  /// Messages discarded since creation because their channel's buffer was
+  /// full, or was resized below what it held.
+  public var discardedMessageCount: Int {
+    state.withLock { $0.discardedMessageCount }
+  }
+
+  /// The number of messages held for `channel`, awaiting a handler.
+  public func bufferedMessageCount(on channel: String) -> Int {
+    state.withLock { $0.buffers[channel]?.pending.count ?? 0 }
+  }
+
+  // MARK: - dispatch
+
+  private func deliver(on channel: String, message: Data?, reply: Reply?) {
+    guard channel != kControlChannelName else {
+      controlChannelBuffers(message)
+      reply?(nil)
+      return
+    }
+
+    let received = ContinuousClock.now
+    let instrumentation = instrumentation
+
+    var discarded = [Reply?]()
+    let registration = state.withLock { state -> Registration? in
+      if let registration = state.registrations[channel] {
+        return registration
+      }
+      var buffer = state.buffers[channel, default: ChannelBuffer()]
+      buffer.pending.append((message, received, reply))
+      discarded = buffer.discardExcess()
+      state.buffers[channel] = buffer
+      if !discarded.isEmpty, !buffer.allowsOverflow {
+        debugPrint(
+          "Warning: a message on channel '\(channel)' was discarded before it could " +
+            "be handled; resize its buffer, or allow it to overflow"
+        )
+      }
+      state.discardedMessageCount += discarded.count
+      return nil
+    }
+    if let registration {
+      registration.metrics.recordReceived(in: instrumentation, byteCount: message?.count ?? 0)
+    } else {
+      instrumentation?.metrics(for: channel).recordReceived(byteCount: message?.count ?? 0)
+    }
+    for reply in discarded {
+      reply?(nil)
+    }
+    if let registration {
+      handle(message, on: channel, received: received, reply: reply, to: registration)
+    }
+  }
+
+  private func handle(
+    _ message: Data?,
+    on channel: String,
+    received: ContinuousClock.Instant,
+    reply: Reply?,
+    to registration: Registration
+  ) {
+    let instrumentation = instrumentation
+    let job: _FlutterMessageQueue.Job = { [registration] in
+      let started = ContinuousClock.now
+      registration.metrics.record(.queue, in: instrumentation, from: received, to: started)
+      // as on the engine, a handler that throws is replied to with nothing
+      let response = try? await registration.handler(message)
+      registration.metrics.record(.handler, in: instrumentation, from: started)
+      reply?(response)
+    }
+    _dispatchMessage(
+      job,
+      on: channel,
+      priority: registration.priority,
+      queue: registration.queue,
+      scheduler: scheduler
+    )
+  }
+
+  private func controlChannelBuffers(_ message: Data?) {
+    guard let message,
+          let call: FlutterMethodCall<[AnyFlutterStandardCodable]> =
+          try? FlutterStandardMessageCodec.shared.decode(message),
+          let arguments = call.arguments, arguments.count == 2,
+          case let .string(channel) = arguments[0]
+    else {
+      debugPrint("Error: malformed message on channel '\(kControlChannelName)'")
+      return
+    }
+
+    var discarded = [Reply?]()
+    state.withLock { state in
+      var buffer = state.buffers[channel, default: ChannelBuffer()]
+      switch (call.method, arguments[1]) {
+      case let ("resize", .int32(capacity)):
+        buffer.capacity = max(Int(capacity), 0)
+        discarded = buffer.discardExcess()
+        state.discardedMessageCount += discarded.count
+      case ("overflow", .true):
+        buffer.allowsOverflow = true
+      case ("overflow", .false):
+        buffer.allowsOverflow = false
+      default:
+        debugPrint("Error: unknown method '\(call.method)' on '\(kControlChannelName)'")
+      }
+      state.buffers[channel] = buffer
+    }
+    for reply in discarded {
+      reply?(nil)
+    }
+  }
+
+  // MARK: - FlutterBinaryMessenger
+
+  @FlutterPlatformThreadActor
+  public func send(on channel: String, message: Data?) throws {
+    instrumentation?.metrics(for: channel).recordSent(byteCount: message?.count ?? 0)
+    deliver(on: channel, message: message, reply: nil)
+  }
+
+  @FlutterPlatformThreadActor
+  public func send(
+    on channel: String,
+    message: Data?,
+    priority: TaskPriority?
+  ) async throws -> Data? {
+    let instrumentation = instrumentation
+    // looked up once per send: a channel sending by name has no registration here
+    let metrics = instrumentation?.metrics(for: channel)
+    metrics?.recordSent(byteCount: message?.count ?? 0)
+    let sent = ContinuousClock.now
+    return await withCheckedContinuation { continuation in
+      deliver(on: channel, message: message) { reply in
+        if let instrumentation, let metrics {
+          instrumentation.record(.response, in: metrics, from: sent)
+        }
+        continuation.resume(returning: reply)
+      }
+    }
+  }
+
+  public func setMessageHandler(
+    on channel: String,
+    handler: FlutterBinaryMessageHandler?,
+    priority: TaskPriority?
+  ) throws -> FlutterBinaryMessengerConnection {
+    try setMessageHandler(on: channel, handler: handler, priority: priority, dispatch: .concurrent)
+  }
+
+  public func setMessageHandler(
+    on channel: String,
+    handler: FlutterBinaryMessageHandler?,
+    priority: TaskPriority?,
+    dispatch: FlutterMessageDispatch
+  ) throws -> FlutterBinaryMessengerConnection {
+    guard let handler else {
+      state.withLock { $0.registrations.removeValue(forKey: channel) }?.queue?.finish()
+      return 0
+    }
+
+    let registration = Registration(
+      connection: lastConnection.wrappingIncrementThenLoad(by: 1, ordering: .relaxed),
+      handler: handler,
+      priority: priority,
+      queue: _FlutterMessageQueue(dispatch, priority: priority),
+      metrics: _FlutterChannelMetricsCache(channel: channel)
+    )
+    let (replaced, pending) = state.withLock { state in
+      defer { state.buffers[channel]?.pending.removeAll() }
+      return (
+        state.registrations.updateValue(registration, forKey: channel),
+        state.buffers[channel]?.pending ?? []
+      )
+    }
+    replaced?.queue?.finish()
+    for (message, received, reply) in pending {
+      handle(message, on: channel, received: received, reply: reply, to: registration)
+    }
+    return registration.connection
+  }
+
+  public func cleanUp(connection: FlutterBinaryMessengerConnection) throws {
+    let removed = state.withLock { state -> Registration? in
+      guard let channel = state.registrations
+        .first(where: { $0.value.connection == connection })?.key
+      else {
+        return nil
+      }
+      return state.registrations.removeValue(forKey: channel)
+    }
+    removed?.queue?.finish()
+  }
+}
@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Synchronization
+
+/// How a messenger runs the handler for each message arriving on a channel.
+public enum FlutterMessageDispatch: Hashable, Sendable {
+  /// Each message is handled on a task of its own, as soon as it arrives.
+  /// Handlers run concurrently, and may start in any order.
+  case concurrent
+
+  /// Messages are handled in the order they arrived, by at most
+  /// `maximumConcurrency` handlers at once, on tasks the channel keeps for its
+  /// lifetime. With a `maximumConcurrency` of 1, the default, each handler
+  /// finishes before the next message's starts.
+  case serial(maximumConcurrency: Int = 1)
+}
+
+/**
+ * The tasks handling a channel's messages under `FlutterMessageDispatch.serial`.
+ *
+ * Each of `maximumConcurrency` workers takes the oldest message's handler from
+ * the queue and runs it to completion, so handlers start in arrival order and
+ * no task is created per message: an idle worker costs a continuation, and a
+ * busy one nothing, where `.concurrent` spawns a task for every message.
+ *
+ * `finish()` is called when the channel's handler is replaced or removed. The
+ * workers drain what is already queued — on eLinux, each must be replied to
+ * for the engine to free its buffer — and then exit.
+ */
+final class _FlutterMessageQueue: Sendable {
+  typealias Job = @Sendable () async -> ()
+
+  private struct State {
+    // a slot is cleared as its job is taken, so a finished handler's captures
+    // (the message, its reply) are released at once rather than at compaction
+    var jobs = [Job?]()
+    var head = 0
+    var waiters = [CheckedContinuation<Job?, Never>]()
+    var isFinished = false
+
+    mutating func popFirst() -> Job? {
+      guard head < jobs.count else { return nil }
+      let job = jobs[head].take()
+      head += 1
+      // reclaim the consumed prefix once it is the larger part of the array
+      if head == jobs.count {
+        jobs.removeAll(keepingCapacity: true)
+        head = 0
+      } else if head > 32, head * 2 > jobs.count {
+        jobs.removeFirst(head)
+        head = 0
+      }
+      return job
+    }
+  }
+
+  private let state = Mutex(State())
+  private let priority: TaskPriority?
+
+  init(maximumConcurrency: Int, priority: TaskPriority?) {
+    precondition(maximumConcurrency > 0)
+    self.priority = priority
+    for _ in 0..<maximumConcurrency {
+      Task(priority: priority) { [self] in
+        while let job = await next() {
+          await job()
+        }
+      }
+    }
+  }
+
+  /// `nil` for `.concurrent`, which needs no queue.
+  convenience init?(_ dispatch: FlutterMessageDispatch, priority: TaskPriority?) {
+    guard case let .serial(maximumConcurrency) = dispatch else { return nil }
+    self.init(maximumConcurrency: maximumConcurrency, priority: priority)
+  }
+
+  func enqueue(_ job: @escaping Job) {
+    let waiter = state.withLock { state -> CheckedContinuation<Job?, Never>?? in
+      guard !state.isFinished else { return .none }
+      guard state.waiters.isEmpty else { return .some(state.waiters.removeFirst()) }
+      state.jobs.append(job)
+      return .some(nil)
+    }
+    switch waiter {
+    case let .some(waiter):
+      waiter?.resume(returning: job)
+    case .none:
+      // a message that raced the handler's removal must still be replied to
+      Task(priority: priority) { await job() }
+    }
+  }
+
+  func finish() {
+    let waiters = state.withLock { state in
+      state.isFinished = true
+      defer { state.waiters.removeAll() }
+      return state.waiters
+    }
+    for waiter in waiters {
+      waiter.resume(returning: nil)
+    }
+  }
+
+  private func next() async -> Job? {
+    await withCheckedContinuation { continuation in
+      let next = state.withLock { state -> Job?? in
+        if let job = state.popFirst() { return .some(job) }
+        if state.isFinished { return .some(nil) }
+        state.waiters.append(continuation)
+        return .none
+      }
+      if let next {
+        continuation.resume(returning: next)
+      }
+    }
+  }
+}
@@ -0,0 +1,286 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import Synchronization
+#if canImport(FoundationEssentials)
+import FoundationEssentials
+#else
+import Foundation
+#endif
+
+/// How urgently a channel's messages are handled, under a
+/// `FlutterMessageScheduler`.
+public enum FlutterSchedulingClass: Int, CaseIterable, Hashable, Sendable {
+  /// Input, gestures, and anything else the user is waiting on.
+  case interactive
+  /// The default.
+  case normal
+  /// Transfers, sync and other background traffic, which can wait.
+  case bulk
+
+  /// The priority of the tasks handling the class's messages, unless the
+  /// channel sets its own.
+  public var taskPriority: TaskPriority {
+    switch self {
+    case .interactive: .userInitiated
+    case .normal: .medium
+    case .bulk: .utility
+    }
+  }
+}
+
+/**
+ * Admission control for the handlers of a messenger's incoming messages.
+ *
+ * Without a scheduler, each message's handler is started as soon as it
+ * arrives, and a flood on one channel delays every other. With one, set as the
+ * messenger's `scheduler`, each channel is classified as `.interactive`,
+ * `.normal` or `.bulk`, and its messages are queued by class:
+ *
+ * - At most `maximumConcurrency` handlers run at once, of which
+ *   `interactiveReserve` slots are only ever given to interactive messages, so
+ *   an interactive message never waits behind a full house of bulk handlers.
+ * - When a slot frees, the queued classes share it by weighted fair queuing:
+ *   each message's virtual finish time is its class's last, or the scheduler's
+ *   current virtual time if later, plus 1 / the class's weight, and the message
+ *   with the earliest is started next. With the default weights, interactive
+ *   messages are started 16 times as often as bulk ones while both are queued,
+ *   and a class with nothing queued accrues no credit.
+ *
+ * A handler holds its slot until it returns, including while it is suspended
+ * awaiting a timer, I/O or another channel's reply; the slot is not lent out
+ * in the meantime. Handlers that mostly wait therefore fill the shared slots
+ * as surely as busy ones, and `maximumConcurrency` should allow for them.
+ *
+ * Within a class, messages start in arrival order. A channel registered with
+ * `FlutterMessageDispatch.serial` keeps its own order; each of its messages is
+ * admitted here in turn.
+ *
+ * `snapshot()` reports each class's queue depth and high-water mark, its
+ * running handlers, and a histogram of the time its messages waited.
+ */
+public final class FlutterMessageScheduler: Sendable {
+  public struct ClassSnapshot: Sendable {
+    public let queueDepth: Int
+    /// The deepest the queue has been.
+    public let maximumQueueDepth: Int
+    public let running: Int
+    public let dispatched: Int
+    /// From submission to the handler's start.
+    public let waitTime: FlutterLatencyHistogram.Snapshot
+  }
+
+  typealias Job = @Sendable () async -> ()
+
+  private struct Entry {
+    let job: Job
+    let priority: TaskPriority?
+    let submitted: ContinuousClock.Instant
+    let finishTag: Double
+  }
+
+  private struct ClassState {
+    var entries = [Entry]()
+    var head = 0
+    var lastFinishTag = 0.0
+    var running = 0
+    var dispatched = 0
+    var maximumQueueDepth = 0
+
+    var queueDepth: Int { entries.count - head }
+
+    mutating func popFirst() -> Entry {
+      defer {
+        head += 1
+        if head == entries.count {
+          entries.removeAll(keepingCapacity: true)
+          head = 0
+        } else if head > 32, head * 2 > entries.count {
+          entries.removeFirst(head)
+          head = 0
+        }
+      }
+      return entries[head]
+    }
+  }
+
+  private struct State {
+    var classes = [ClassState](
+      repeating: ClassState(),
+      count: FlutterSchedulingClass.allCases.count
+    )
+    var virtualTime = 0.0
+    var channelClasses = [String: FlutterSchedulingClass]()
+
+    var running: Int { classes.reduce(0) { $0 + $1.running } }
+  }
+
+  public let maximumConcurrency: Int
+  public let interactiveReserve: Int
+  public let weights: [FlutterSchedulingClass: Int]
+  /// The class of channels that have not been classified.
+  public let defaultClass: FlutterSchedulingClass
+
+  private let state = Mutex(State())
+  private let waitTimes = FlutterSchedulingClass.allCases.map { _ in FlutterLatencyHistogram() }
+
+  public init(
+    maximumConcurrency: Int = ProcessInfo.processInfo.activeProcessorCount,
+    interactiveReserve: Int = 1,
+    weights: [FlutterSchedulingClass: Int] = [.interactive: 16, .normal: 4, .bulk: 1],
+    defaultClass: FlutterSchedulingClass = .normal
+  ) {
+    precondition(interactiveReserve >= 0 && maximumConcurrency > interactiveReserve)
+    precondition(FlutterSchedulingClass.allCases.allSatisfy { (weights[$0] ?? 0) > 0 })
+    self.maximumConcurrency = maximumConcurrency
+    self.interactiveReserve = interactiveReserve
+    self.weights = weights
+    self.defaultClass = defaultClass
+  }
+
+  /// Handles `channel`'s messages, from now on, as `schedulingClass`.
+  public func classify(_ channel: String, as schedulingClass: FlutterSchedulingClass) {
+    state.withLock { $0.channelClasses[channel] = schedulingClass }
+  }
+
+  public func schedulingClass(of channel: String) -> FlutterSchedulingClass {
+    state.withLock { $0.channelClasses[channel] } ?? defaultClass
+  }
+
+  /// Messages awaiting a handler, in `schedulingClass`.
+  public func queueDepth(_ schedulingClass: FlutterSchedulingClass) -> Int {
+    state.withLock { $0.classes[schedulingClass.rawValue].queueDepth }
+  }
+
+  public func snapshot() -> [FlutterSchedulingClass: ClassSnapshot] {
+    let classes = state.withLock { $0.classes }
+    return Dictionary(uniqueKeysWithValues: FlutterSchedulingClass.allCases.map {
+      let state = classes[$0.rawValue]
+      return ($0, ClassSnapshot(
+        queueDepth: state.queueDepth,
+        maximumQueueDepth: state.maximumQueueDepth,
+        running: state.running,
+        dispatched: state.dispatched,
+        waitTime: waitTimes[$0.rawValue].snapshot()
+      ))
+    })
+  }
+
+  // MARK: - scheduling
+
+  /// Queues `job`, a handler for a message on `channel`, to run on a task of
+  /// its own once admitted.
+  func schedule(_ job: @escaping Job, on channel: String, priority: TaskPriority?) {
+    let submitted = ContinuousClock.now
+    let admitted = state.withLock { state in
+      let schedulingClass = state.channelClasses[channel] ?? defaultClass
+      let index = schedulingClass.rawValue
+      let finishTag = max(state.virtualTime, state.classes[index].lastFinishTag) +
+        1 / Double(weights[schedulingClass]!)
+      state.classes[index].lastFinishTag = finishTag
+      state.classes[index].entries.append(Entry(
+        job: job,
+        priority: priority,
+        submitted: submitted,
+        finishTag: finishTag
+      ))
+      state.classes[index].maximumQueueDepth = max(
+        state.classes[index].maximumQueueDepth,
+        state.classes[index].queueDepth
+      )
+      return admit(&state)
+    }
+    start(admitted)
+  }
+
+  /// Runs `job` once admitted, returning when it completes: for a serial
+  /// channel, whose next message must wait for this one.
+  func run(_ job: @escaping Job, on channel: String, priority: TaskPriority?) async {
+    await withCheckedContinuation { continuation in
+      schedule({
+        await job()
+        continuation.resume()
+      }, on: channel, priority: priority)
+    }
+  }
+
+  /// Removes from the queues the messages that can start now.
+  private func admit(_ state: inout State) -> [(FlutterSchedulingClass, Entry)] {
+    var admitted = [(FlutterSchedulingClass, Entry)]()
+    var running = state.running
+    let sharedCapacity = maximumConcurrency - interactiveReserve
+
+    while running < maximumConcurrency {
+      let shared = running - state.classes[FlutterSchedulingClass.interactive.rawValue].running
+      let next = FlutterSchedulingClass.allCases
+        .filter { state.classes[$0.rawValue].queueDepth > 0 }
+        .filter { $0 == .interactive || shared < sharedCapacity }
+        .min {
+          let lhs = state.classes[$0.rawValue], rhs = state.classes[$1.rawValue]
+          return lhs.entries[lhs.head].finishTag < rhs.entries[rhs.head].finishTag
+        }
+      guard let next else { break }
+
+      let entry = state.classes[next.rawValue].popFirst()
+      state.virtualTime = entry.finishTag
+      state.classes[next.rawValue].running += 1
+      state.classes[next.rawValue].dispatched += 1
+      running += 1
+      admitted.append((next, entry))
+    }
+    return admitted
+  }
+
+  private func start(_ admitted: [(FlutterSchedulingClass, Entry)]) {
+    let now = ContinuousClock.now
+    for (schedulingClass, entry) in admitted {
+      waitTimes[schedulingClass.rawValue].record(entry.submitted.duration(to: now))
+      Task(priority: entry.priority ?? schedulingClass.taskPriority) {
+        await entry.job()
+        self.complete(schedulingClass)
+      }
+    }
+  }
+
+  private func complete(_ schedulingClass: FlutterSchedulingClass) {
+    let admitted = state.withLock { state in
+      state.classes[schedulingClass.rawValue].running -= 1
+      return admit(&state)
+    }
+    start(admitted)
+  }
+}
+
+/// Starts `job`, a handler for a message on `channel`, through the channel's
+/// serial queue and the messenger's scheduler where there are either.
+func _dispatchMessage(
+  _ job: @escaping _FlutterMessageQueue.Job,
+  on channel: String,
+  priority: TaskPriority?,
+  queue: _FlutterMessageQueue?,
+  scheduler: FlutterMessageScheduler?
+) {
+  switch (queue, scheduler) {
+  case let (queue?, scheduler?):
+    queue.enqueue { await scheduler.run(job, on: channel, priority: priority) }
+  case let (queue?, nil):
+    queue.enqueue(job)
+  case let (nil, scheduler?):
+    scheduler.schedule(job, on: channel, priority: priority)
+  case (nil, nil):
+    Task(priority: priority, operation: job)
+  }
+}
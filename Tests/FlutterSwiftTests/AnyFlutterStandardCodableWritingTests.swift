@@ -284,6 +284,79 @@ final class AnyFlutterStandardCodableWritingTests: XCTestCase {
     }
   }
 
+  // MARK: - exact sizing
+
+  /// `encodedByteCount()` runs the same writers into a counter, so what it has
+  /// to get right is the starting offset: padding for a value nested after the
+  /// envelope discriminant differs from padding at the start of a message.
+  func testEncodedByteCountIsExact() throws {
+    for value in Self.everyShapeExceptMaps + Self.maps {
+      XCTAssertEqual(
+        try value.encodedByteCount(),
+        try XCTUnwrap(value._directlyEncoded()).count,
+        "measured size diverged for \(value)"
+      )
+      let envelope = FlutterEnvelope.success(value)
+      XCTAssertEqual(
+        try envelope._directlyEncodedByteCount(),
+        try XCTUnwrap(envelope._directlyEncoded()).count,
+        "measured envelope size diverged for \(value)"
+      )
+    }
+    XCTAssertEqual(try FlutterEnvelope<AnyFlutterStandardCodable>.success(nil)
+      ._directlyEncodedByteCount(), 2)
+    XCTAssertNil(try FlutterEnvelope<AnyFlutterStandardCodable>.failure(
+      FlutterError(code: "oops")
+    )._directlyEncodedByteCount())
+  }
+
+  /// The padding cases spelled out, so a counter that ignored alignment would
+  /// not pass merely by agreeing with itself.
+  func testEncodedByteCountIncludesPadding() throws {
+    // tag, 7 bytes of padding, 8-byte payload
+    XCTAssertEqual(try AnyFlutterStandardCodable.float64(1).encodedByteCount(), 16)
+    // list header (2) + int32 (5), then the float64 tag lands on offset 7 and
+    // its payload on 8
+    XCTAssertEqual(
+      try AnyFlutterStandardCodable.list([.int32(1), .float64(1)]).encodedByteCount(),
+      16
+    )
+    // after the discriminant the same float64 needs only 6 bytes of padding
+    XCTAssertEqual(
+      try FlutterEnvelope.success(AnyFlutterStandardCodable.float64(1))
+        ._directlyEncodedByteCount(),
+      16
+    )
+    XCTAssertEqual(try AnyFlutterStandardCodable.int64Data([]).encodedByteCount(), 8)
+  }
+
+  /// The point of measuring: a buffer reserved at the measured size is never
+  /// reallocated while a large nested value is written into it.
+  func testExactlyReservedBufferIsNotReallocated() throws {
+    let value = AnyFlutterStandardCodable.list((0..<64).map { i in
+      .map([
+        .string("samples"): .float64Data(Array(repeating: Double(i), count: 100)),
+        .string("label"): .string(String(repeating: "x", count: i * 5)),
+        .string("nested"): .list([.int32(Int32(i)), .float64(0.5), .int64Data([1, 2, 3])]),
+      ])
+    })
+    let byteCount = try value.encodedByteCount()
+    var buffer = [UInt8]()
+    buffer.reserveCapacity(byteCount)
+    let before = buffer.withUnsafeBufferPointer { $0.baseAddress }
+    try value.write(into: &buffer)
+    XCTAssertEqual(buffer.count, byteCount)
+    XCTAssertEqual(buffer.withUnsafeBufferPointer { $0.baseAddress }, before)
+
+    // and presizing changes nothing about what the codec produces
+    let codec = FlutterStandardMessageCodec(
+      bufferPool: FlutterStandardBufferPool(),
+      presizesExactly: true
+    )
+    let decoded: AnyFlutterStandardCodable = try codec.decode(codec.encode(value))
+    XCTAssertEqual(decoded, value)
+  }
+
   // MARK: - helpers
 
   /// Encodes via the `Codable` path, bypassing the direct-writer fast path so
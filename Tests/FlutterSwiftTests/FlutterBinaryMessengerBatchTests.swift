@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import XCTest
+
+/// Relies on the protocol's default `send(batch:)`, recording each message
+/// sent and refusing those on `refusedChannel`.
+@FlutterPlatformThreadActor
+private final class RecordingMessenger: FlutterBinaryMessenger {
+  static let refusedChannel = "refused"
+
+  var sent = [FlutterBinaryMessage]()
+
+  func send(on channel: String, message: Data?) throws {
+    guard channel != Self.refusedChannel else {
+      throw FlutterSwiftError.messageSendFailure
+    }
+    sent.append((channel, message))
+  }
+
+  func send(on channel: String, message: Data?, priority: TaskPriority?) async throws -> Data? {
+    try send(on: channel, message: message)
+    return nil
+  }
+
+  nonisolated func setMessageHandler(
+    on channel: String,
+    handler: FlutterBinaryMessageHandler?,
+    priority: TaskPriority?
+  ) throws -> FlutterBinaryMessengerConnection {
+    0
+  }
+
+  nonisolated func cleanUp(connection: FlutterBinaryMessengerConnection) throws {}
+}
+
+final class FlutterBinaryMessengerBatchTests: XCTestCase {
+  private func message(_ byte: UInt8) -> Data {
+    Data([byte])
+  }
+
+  @FlutterPlatformThreadActor
+  func testDefaultBatchSendsInOrder() {
+    let messenger = RecordingMessenger()
+    let batch: [FlutterBinaryMessage] = [
+      ("a", message(0)), ("b", message(1)), ("a", nil), ("c", message(3)),
+    ]
+
+    let results = messenger.send(batch: batch)
+    XCTAssertEqual(results.count, batch.count)
+    for result in results {
+      XCTAssertNoThrow(try result.get())
+    }
+    XCTAssertEqual(messenger.sent.map(\.channel), ["a", "b", "a", "c"])
+    XCTAssertEqual(messenger.sent.map(\.message), [message(0), message(1), nil, message(3)])
+  }
+
+  @FlutterPlatformThreadActor
+  func testDefaultBatchFailsOnlyAtFailingIndex() {
+    let messenger = RecordingMessenger()
+    let batch: [FlutterBinaryMessage] = [
+      ("a", message(0)), (RecordingMessenger.refusedChannel, message(1)), ("a", message(2)),
+    ]
+
+    let results = messenger.send(batch: batch)
+    XCTAssertEqual(results.count, batch.count)
+    XCTAssertNoThrow(try results[0].get())
+    XCTAssertThrowsError(try results[1].get()) { error in
+      XCTAssertEqual(error as? FlutterSwiftError, .messageSendFailure)
+    }
+    XCTAssertNoThrow(try results[2].get())
+    // the failure did not stop the message after it
+    XCTAssertEqual(messenger.sent.map(\.message), [message(0), message(2)])
+  }
+
+  @FlutterPlatformThreadActor
+  func testLoopbackBatchDeliversInOrder() async throws {
+    let messenger = FlutterLoopbackMessenger()
+    let (received, continuation) = AsyncStream.makeStream(of: Data?.self)
+    _ = try messenger.setMessageHandler(
+      on: "batched",
+      handler: { message in
+        continuation.yield(message)
+        return nil
+      },
+      priority: nil,
+      dispatch: .serial()
+    )
+    let messages = (UInt8(0)..<8).map { message($0) }
+
+    let results = messenger.send(batch: messages.map { ("batched", $0) })
+    XCTAssertEqual(results.count, messages.count)
+    for result in results {
+      XCTAssertNoThrow(try result.get())
+    }
+
+    var delivered = [Data?]()
+    for await message in received {
+      delivered.append(message)
+      if delivered.count == messages.count { break }
+    }
+    XCTAssertEqual(delivered, messages)
+  }
+
+  /// A message with no handler to go to is held, as by the framework's channel
+  /// buffers, without holding up the rest of the batch.
+  @FlutterPlatformThreadActor
+  func testLoopbackBatchBuffersUnhandledChannel() async throws {
+    let messenger = FlutterLoopbackMessenger()
+    let (received, continuation) = AsyncStream.makeStream(of: Data?.self)
+    _ = try messenger.setMessageHandler(
+      on: "handled",
+      handler: { message in
+        continuation.yield(message)
+        return nil
+      },
+      priority: nil,
+      dispatch: .serial()
+    )
+
+    let results = messenger.send(batch: [
+      ("handled", message(0)), ("unhandled", message(1)), ("handled", message(2)),
+    ])
+    XCTAssertEqual(results.count, 3)
+    for result in results {
+      XCTAssertNoThrow(try result.get())
+    }
+
+    var delivered = [Data?]()
+    for await message in received {
+      delivered.append(message)
+      if delivered.count == 2 { break }
+    }
+    XCTAssertEqual(delivered, [message(0), message(2)])
+    XCTAssertEqual(messenger.bufferedMessageCount(on: "unhandled"), 1)
+  }
+}
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import XCTest
+
+final class FlutterChannelInstrumentationTests: XCTestCase {
+  func testHistogramBuckets() {
+    let histogram = FlutterLatencyHistogram()
+    histogram.record(.zero)
+    histogram.record(.nanoseconds(1))
+    histogram.record(.nanoseconds(1000))
+    histogram.record(.milliseconds(1))
+
+    let snapshot = histogram.snapshot()
+    XCTAssertEqual(snapshot.count, 4)
+    XCTAssertEqual(snapshot.buckets[0], 2)
+    // 1000 ns is in [512, 1024), 1 ms in [2^19, 2^20)
+    XCTAssertEqual(snapshot.buckets[9], 1)
+    XCTAssertEqual(snapshot.buckets[19], 1)
+    XCTAssertEqual(snapshot.total, .nanoseconds(1_001_001))
+    XCTAssertEqual(snapshot.percentile(50), .nanoseconds(2))
+    XCTAssertEqual(snapshot.percentile(75), .nanoseconds(1024))
+    XCTAssertEqual(snapshot.percentile(100), .nanoseconds(1 << 20))
+  }
+
+  @FlutterPlatformThreadActor
+  func testRecordsRoundTrips() async throws {
+    let instrumentation = FlutterChannelInstrumentation()
+    let messenger = FlutterLoopbackMessenger()
+    messenger.instrumentation = instrumentation
+    let channel = FlutterMethodChannel(name: "measured", binaryMessenger: messenger)
+    try channel.setMethodCallHandler { (call: FlutterMethodCall<Int32>) -> Int32? in
+      call.arguments.map { $0 + 1 }
+    }
+
+    for value in Int32(0)..<3 {
+      let reply: Int32? = try await channel.invoke(method: "increment", arguments: value)
+      XCTAssertEqual(reply, value + 1)
+    }
+
+    let metrics = try XCTUnwrap(instrumentation.snapshot()["measured"])
+    XCTAssertEqual(metrics.messagesSent, 3)
+    XCTAssertEqual(metrics.messagesReceived, 3)
+    XCTAssertEqual(metrics.bytesSent, metrics.bytesReceived)
+    XCTAssertGreaterThan(metrics.bytesSent, 0)
+    for phase in [FlutterChannelPhase.queue, .handler, .response] {
+      XCTAssertEqual(metrics.latencies[phase]?.count, 3, "\(phase)")
+    }
+    // the call and reply on each side
+    XCTAssertEqual(metrics.latencies[.encode]?.count, 6)
+    XCTAssertEqual(metrics.latencies[.decode]?.count, 6)
+  }
+
+  @FlutterPlatformThreadActor
+  func testResetKeepsRecording() async throws {
+    let instrumentation = FlutterChannelInstrumentation()
+    let messenger = FlutterLoopbackMessenger()
+    messenger.instrumentation = instrumentation
+    let channel = FlutterBasicMessageChannel(name: "reset", binaryMessenger: messenger)
+    try channel.setMessageHandler { (message: String?) -> String? in message }
+
+    _ = try await channel.send(message: "before", reply: String.self)
+    instrumentation.reset()
+    XCTAssertEqual(instrumentation.snapshot()["reset"]?.messagesReceived, 0)
+
+    // the channel and the registration still hold the metrics reset() zeroed
+    _ = try await channel.send(message: "after", reply: String.self)
+    let metrics = try XCTUnwrap(instrumentation.snapshot()["reset"])
+    XCTAssertEqual(metrics.messagesReceived, 1)
+    XCTAssertEqual(metrics.latencies[.handler]?.count, 1)
+    XCTAssertEqual(metrics.latencies[.encode]?.count, 2)
+  }
+
+  @FlutterPlatformThreadActor
+  func testTraceExport() async throws {
+    let instrumentation = FlutterChannelInstrumentation()
+    let messenger = FlutterLoopbackMessenger()
+    messenger.instrumentation = instrumentation
+    let channel = FlutterBasicMessageChannel(name: "traced", binaryMessenger: messenger)
+    try channel.setMessageHandler { (message: String?) -> String? in message }
+
+    XCTAssertNil(try instrumentation.stopTracing())
+    instrumentation.startTracing(maximumEventCount: 4)
+    for _ in 0..<2 {
+      _ = try await channel.send(message: "ping", reply: String.self)
+    }
+    let trace = try XCTUnwrap(instrumentation.stopTracing())
+
+    let object = try XCTUnwrap(JSONSerialization.jsonObject(with: trace) as? [String: Any])
+    let events = try XCTUnwrap(object["traceEvents"] as? [[String: Any]])
+    let complete = events.filter { $0["ph"] as? String == "X" }
+    XCTAssertEqual(complete.count, 4)
+    let metadata = events.filter { $0["ph"] as? String == "M" }
+    XCTAssertEqual(metadata.count, 1)
+    XCTAssertEqual((metadata.first?["args"] as? [String: String])?["name"], "traced")
+  }
+}
@@ -0,0 +1,225 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import XCTest
+
+/// Plays the Dart side of a chunked transfer: reassembles each transfer at the
+/// offsets its chunks carry, and acknowledges them.
+@FlutterPlatformThreadActor
+private final class ReassemblingMessenger: FlutterBinaryMessenger {
+  var payloads = [Int64: Data]()
+  var completed = Set<Int64>()
+  var aborted = Set<Int64>()
+  var chunkCount = 0
+  var inFlight = 0
+  var maxInFlight = 0
+  /// Chunks past this many are refused.
+  var acknowledgedChunkLimit = Int.max
+
+  private let codec = FlutterStandardMessageCodec.shared
+
+  private func receive(_ message: Data?) throws -> Bool {
+    guard let message,
+          case let .list(fields) = try codec.decode(message) as AnyFlutterStandardCodable,
+          fields.count == 5,
+          case let .int32(kind) = fields[0],
+          case let .int64(transfer) = fields[1],
+          case let .int64(offset) = fields[2]
+    else {
+      XCTFail("malformed transfer message")
+      return false
+    }
+    switch kind {
+    case 0:
+      guard case let .uint8Data(bytes) = fields[4] else {
+        XCTFail("chunk without payload")
+        return false
+      }
+      chunkCount += 1
+      guard chunkCount <= acknowledgedChunkLimit else { return false }
+      var payload = payloads[transfer] ?? Data()
+      let end = Int(offset) + bytes.count
+      if payload.count < end {
+        payload.append(Data(count: end - payload.count))
+      }
+      payload.replaceSubrange(Int(offset)..<end, with: bytes)
+      payloads[transfer] = payload
+    case 1:
+      XCTAssertEqual(Int(offset), payloads[transfer]?.count ?? 0)
+      completed.insert(transfer)
+    default:
+      aborted.insert(transfer)
+    }
+    return true
+  }
+
+  func send(on channel: String, message: Data?) throws {
+    _ = try receive(message)
+  }
+
+  func send(on channel: String, message: Data?, priority: TaskPriority?) async throws -> Data? {
+    inFlight += 1
+    maxInFlight = max(maxInFlight, inFlight)
+    defer { inFlight -= 1 }
+    // let the sender's other chunks in, as a real round trip would
+    await Task.yield()
+    return try codec.encode(receive(message))
+  }
+
+  nonisolated func setMessageHandler(
+    on channel: String,
+    handler: FlutterBinaryMessageHandler?,
+    priority: TaskPriority?
+  ) throws -> FlutterBinaryMessengerConnection {
+    0
+  }
+
+  nonisolated func cleanUp(connection: FlutterBinaryMessengerConnection) throws {}
+}
+
+final class FlutterChunkedTransferChannelTests: XCTestCase {
+  private func payload(_ count: Int) -> Data {
+    Data((0..<count).map { UInt8(truncatingIfNeeded: $0 &* 31) })
+  }
+
+  private func chunks(_ payload: Data) -> AsyncStream<Data> {
+    AsyncStream { continuation in
+      continuation.yield(payload)
+      continuation.finish()
+    }
+  }
+
+  @FlutterPlatformThreadActor
+  func testReassemblesPayload() async throws {
+    let messenger = ReassemblingMessenger()
+    let channel = FlutterChunkedTransferChannel(
+      name: "transfer",
+      binaryMessenger: messenger,
+      chunkSize: 1000,
+      window: 3
+    )
+    let payload = payload(10500)
+    try await channel.send(payload)
+
+    XCTAssertEqual(messenger.payloads[0], payload)
+    XCTAssertEqual(messenger.completed, [0])
+    XCTAssertEqual(messenger.chunkCount, 11)
+    XCTAssertLessThanOrEqual(messenger.maxInFlight, 3)
+
+    // the next transfer has its own identifier
+    try await channel.send(payload.prefix(10))
+    XCTAssertEqual(messenger.payloads[1], payload.prefix(10))
+    XCTAssertEqual(messenger.completed, [0, 1])
+  }
+
+  @FlutterPlatformThreadActor
+  func testSplitsButNeverMergesElements() async throws {
+    let messenger = ReassemblingMessenger()
+    let channel = FlutterChunkedTransferChannel(
+      name: "transfer",
+      binaryMessenger: messenger,
+      chunkSize: 1024
+    )
+    let pieces = [payload(2500), payload(10), payload(3000)]
+    let chunks = AsyncStream<Data> { continuation in
+      pieces.forEach { continuation.yield($0) }
+      continuation.finish()
+    }
+    try await channel.send(chunks: chunks)
+
+    XCTAssertEqual(messenger.payloads[0], pieces.reduce(Data(), +))
+    // 3 + 1 + 3: the 10-byte element is sent alone, not merged with a neighbour
+    XCTAssertEqual(messenger.chunkCount, 7)
+    XCTAssertEqual(messenger.completed, [0])
+  }
+
+  @FlutterPlatformThreadActor
+  func testReceiverCancels() async throws {
+    let messenger = ReassemblingMessenger()
+    messenger.acknowledgedChunkLimit = 2
+    let channel = FlutterChunkedTransferChannel(
+      name: "transfer",
+      binaryMessenger: messenger,
+      chunkSize: 100,
+      window: 1
+    )
+    do {
+      try await channel.send(payload(1000))
+      XCTFail("expected the transfer to be cancelled")
+    } catch {
+      XCTAssertEqual(error as? FlutterSwiftError, .transferCancelled)
+    }
+    XCTAssertEqual(messenger.chunkCount, 3)
+    XCTAssertTrue(messenger.completed.isEmpty)
+    XCTAssertEqual(messenger.aborted, [0])
+  }
+
+  @FlutterPlatformThreadActor
+  func testRejectsLongerPayloadThanAnnounced() async throws {
+    let messenger = ReassemblingMessenger()
+    let channel = FlutterChunkedTransferChannel(
+      name: "transfer",
+      binaryMessenger: messenger,
+      chunkSize: 100,
+      window: 1
+    )
+    do {
+      try await channel.send(byteCount: 450, chunks: chunks(payload(1000)))
+      XCTFail("expected a size mismatch")
+    } catch {
+      XCTAssertEqual(error as? FlutterSwiftError, .transferSizeMismatch)
+    }
+    // the chunk that would overrun the announced size is never sent
+    XCTAssertEqual(messenger.chunkCount, 4)
+    XCTAssertTrue(messenger.completed.isEmpty)
+    XCTAssertEqual(messenger.aborted, [0])
+  }
+
+  @FlutterPlatformThreadActor
+  func testRejectsShorterPayloadThanAnnounced() async throws {
+    let messenger = ReassemblingMessenger()
+    let channel = FlutterChunkedTransferChannel(
+      name: "transfer",
+      binaryMessenger: messenger,
+      chunkSize: 100,
+      window: 1
+    )
+    do {
+      try await channel.send(byteCount: 1000, chunks: chunks(payload(500)))
+      XCTFail("expected a size mismatch")
+    } catch {
+      XCTAssertEqual(error as? FlutterSwiftError, .transferSizeMismatch)
+    }
+    XCTAssertEqual(messenger.chunkCount, 5)
+    XCTAssertTrue(messenger.completed.isEmpty)
+    XCTAssertEqual(messenger.aborted, [0])
+  }
+
+  /// A full chunk at the default size is encoded into a buffer the pool keeps.
+  func testDefaultChunkFitsPooledBuffer() throws {
+    let pool = FlutterStandardBufferPool()
+    let chunk = FlutterTransferMessage(
+      kind: .chunk,
+      transfer: 0,
+      offset: 0,
+      byteCount: Int(Int64.max),
+      payload: Data(count: FlutterChunkedTransferChannel.defaultChunkSize)
+    )
+    _ = try FlutterStandardEncoder(bufferPool: pool).encode(chunk)
+    XCTAssertEqual(pool.idleCount, 1)
+  }
+}
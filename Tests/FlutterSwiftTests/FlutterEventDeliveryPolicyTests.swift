@@ -0,0 +1,256 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+import AsyncExtensions
+@testable import FlutterSwift
+import XCTest
+
+/// Subscribes to an event channel over a `FlutterLoopbackMessenger`, as the
+/// Dart side would: a `listen#1` call, with the events arriving on `name#1`.
+@FlutterPlatformThreadActor
+private final class Subscriber {
+  let messenger = FlutterLoopbackMessenger()
+  let codec = FlutterStandardMessageCodec.shared
+  /// Each message received on the event stream's name; `nil` is end-of-stream.
+  let messages: AsyncStream<Data?>
+
+  private let channelName: String
+
+  init(channelName: String) throws {
+    self.channelName = channelName
+    let (messages, continuation) = AsyncStream.makeStream(of: Data?.self)
+    self.messages = messages
+    // serial, so that the messages are seen in the order they were sent
+    _ = try messenger.setMessageHandler(
+      on: channelName + "#1",
+      handler: { message in
+        continuation.yield(message)
+        return nil
+      },
+      priority: nil,
+      dispatch: .serial()
+    )
+  }
+
+  func call(_ method: String) async throws {
+    let call = FlutterMethodCall<FlutterNull>(method: method + "#1", arguments: nil)
+    _ = try await messenger.send(on: channelName, message: codec.encode(call), priority: nil)
+  }
+}
+
+/// Holds the platform thread, as a busy one would, so the channel's sends back
+/// up behind it.
+@FlutterPlatformThreadActor
+private func holdPlatformThread(for duration: Duration) {
+  let deadline = ContinuousClock.now + duration
+  while ContinuousClock.now < deadline {}
+}
+
+final class FlutterEventDeliveryPolicyTests: XCTestCase {
+  private let codec = FlutterStandardMessageCodec.shared
+
+  private func event(_ message: Data?) throws -> Int32? {
+    let message = try XCTUnwrap(message, "unexpected end-of-stream")
+    guard case let .success(value) = try codec.decode(message) as FlutterEnvelope<Int32> else {
+      XCTFail("unexpected error envelope")
+      return nil
+    }
+    return value
+  }
+
+  /// Sends event 0, then, once it has arrived, 1..<`count` while the platform
+  /// thread is held, and returns every event received before end-of-stream.
+  @FlutterPlatformThreadActor
+  private func burst(_ count: Int32, policy: FlutterEventDeliveryPolicy) async throws -> [Int32] {
+    let subscriber = try Subscriber(channelName: "burst")
+    let channel = FlutterEventChannel(
+      name: "burst",
+      binaryMessenger: subscriber.messenger,
+      deliveryPolicy: policy
+    )
+    let (stream, continuation) = AsyncStream.makeStream(of: Int32?.self)
+    try channel.setStreamHandler(
+      onListen: { (_: FlutterNull?) in stream.eraseToAnyAsyncSequence() },
+      onCancel: nil
+    )
+    try await subscriber.call("listen")
+
+    var messages = subscriber.messages.makeAsyncIterator()
+    continuation.yield(0)
+    let first = await messages.next() ?? nil
+    var received = try [XCTUnwrap(event(first))]
+
+    for value in 1..<count {
+      continuation.yield(value)
+    }
+    continuation.finish()
+    holdPlatformThread(for: .milliseconds(100))
+
+    while let message = await messages.next() {
+      guard let message else { break }
+      try received.append(XCTUnwrap(event(message)))
+    }
+    return received
+  }
+
+  func testBufferingNewestDropsOldestUnderSlowSender() async throws {
+    let received = try await burst(10, policy: .bufferingNewest(2))
+    // at most one send's worth got out before the sender stalled; of the rest,
+    // only the newest two were still buffered when it resumed
+    XCTAssertEqual(received.first, 0)
+    XCTAssertEqual(Array(received.suffix(2)), [8, 9])
+    XCTAssertLessThanOrEqual(received.count, 5)
+    XCTAssertEqual(received, received.sorted())
+  }
+
+  func testLatestSendsOnlyNewest() async throws {
+    let received = try await burst(10, policy: .latest)
+    XCTAssertEqual(received.first, 0)
+    XCTAssertEqual(received.last, 9)
+    XCTAssertLessThanOrEqual(received.count, 3)
+    XCTAssertEqual(received, received.sorted())
+  }
+
+  func testZeroCapacityIsClampedToOne() async throws {
+    let received = try await burst(4, policy: .bufferingNewest(0))
+    XCTAssertEqual(received.last, 3)
+  }
+
+  @FlutterPlatformThreadActor
+  func testBatchedSendsOneListPerWindow() async throws {
+    let subscriber = try Subscriber(channelName: "batched")
+    let channel = FlutterEventChannel(
+      name: "batched",
+      binaryMessenger: subscriber.messenger,
+      deliveryPolicy: .batched(interval: .milliseconds(100))
+    )
+    let (stream, continuation) = AsyncStream.makeStream(of: Int32?.self)
+    try channel.setStreamHandler(
+      onListen: { (_: FlutterNull?) in stream.eraseToAnyAsyncSequence() },
+      onCancel: nil
+    )
+    try await subscriber.call("listen")
+
+    for value in Int32(0)..<5 {
+      continuation.yield(value)
+    }
+    var messages = subscriber.messages.makeAsyncIterator()
+    let first = await messages.next() ?? nil
+    let batch = try XCTUnwrap(first)
+    guard case let .success(values) = try codec.decode(batch) as FlutterEnvelope<[Int32?]> else {
+      return XCTFail("unexpected error envelope")
+    }
+    XCTAssertEqual(values, [0, 1, 2, 3, 4])
+
+    continuation.yield(5)
+    continuation.finish()
+    let second = await messages.next() ?? nil
+    let last = try XCTUnwrap(second)
+    guard case let .success(values) = try codec.decode(last) as FlutterEnvelope<[Int32?]> else {
+      return XCTFail("unexpected error envelope")
+    }
+    XCTAssertEqual(values, [5])
+    let end = await messages.next()
+    XCTAssertEqual(end, .some(nil))
+  }
+
+  @FlutterPlatformThreadActor
+  func testCompletionDoesNotWaitForWindow() async throws {
+    let subscriber = try Subscriber(channelName: "finished")
+    let channel = FlutterEventChannel(
+      name: "finished",
+      binaryMessenger: subscriber.messenger,
+      deliveryPolicy: .batched(interval: .seconds(60))
+    )
+    try channel.setStreamHandler(
+      onListen: { (_: FlutterNull?) in
+        AsyncStream<Int32?> { $0.finish() }.eraseToAnyAsyncSequence()
+      },
+      onCancel: nil
+    )
+    let start = ContinuousClock.now
+    try await subscriber.call("listen")
+
+    var messages = subscriber.messages.makeAsyncIterator()
+    let end = await messages.next()
+    XCTAssertEqual(end, .some(nil))
+    XCTAssertLessThan(start.duration(to: .now), .seconds(10))
+  }
+
+  @FlutterPlatformThreadActor
+  func testErrorFollowsBufferedEvents() async throws {
+    let subscriber = try Subscriber(channelName: "failing")
+    let channel = FlutterEventChannel(
+      name: "failing",
+      binaryMessenger: subscriber.messenger,
+      deliveryPolicy: .bufferingNewest(16)
+    )
+    let (stream, continuation) = AsyncThrowingStream.makeStream(of: Int32?.self)
+    try channel.setStreamHandler(
+      onListen: { (_: FlutterNull?) in stream.eraseToAnyAsyncSequence() },
+      onCancel: nil
+    )
+    try await subscriber.call("listen")
+
+    for value in Int32(0)..<3 {
+      continuation.yield(value)
+    }
+    continuation.finish(throwing: FlutterError(code: "boom"))
+
+    var received = [Int32]()
+    var messages = subscriber.messages.makeAsyncIterator()
+    while let message = await messages.next() ?? nil {
+      switch try codec.decode(message) as FlutterEnvelope<Int32> {
+      case let .success(value):
+        try received.append(XCTUnwrap(value))
+      case let .failure(error):
+        XCTAssertEqual(error.code, "boom")
+        XCTAssertEqual(received, [0, 1, 2])
+        return
+      }
+    }
+    XCTFail("end-of-stream instead of the error")
+  }
+
+  @FlutterPlatformThreadActor
+  func testCancelStopsProducer() async throws {
+    let subscriber = try Subscriber(channelName: "cancelled")
+    let channel = FlutterEventChannel(
+      name: "cancelled",
+      binaryMessenger: subscriber.messenger,
+      deliveryPolicy: .bufferingNewest(4)
+    )
+    let (stream, continuation) = AsyncStream.makeStream(of: Int32?.self)
+    let (terminated, terminate) = AsyncStream.makeStream(of: Void.self)
+    continuation.onTermination = { _ in terminate.yield() }
+    try channel.setStreamHandler(
+      onListen: { (_: FlutterNull?) in stream.eraseToAnyAsyncSequence() },
+      onCancel: nil
+    )
+    try await subscriber.call("listen")
+
+    continuation.yield(0)
+    var messages = subscriber.messages.makeAsyncIterator()
+    let first = await messages.next() ?? nil
+    XCTAssertEqual(try event(first), 0)
+
+    try await subscriber.call("cancel")
+    // the producer's iteration of the stream is cancelled with the task
+    var iterator = terminated.makeAsyncIterator()
+    await iterator.next()
+    XCTAssertEqual(channel.tasksCount, 0)
+  }
+}
@@ -0,0 +1,108 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import XCTest
+
+final class FlutterHandlerThreadPoolTests: XCTestCase {
+  func testRunsTasksOnPool() async {
+    let pool = FlutterHandlerThreadPool(threadCount: 2)
+    defer { pool.shutdown() }
+
+    XCTAssertFalse(pool.isCurrent)
+    let onPool = await Task(executorPreference: pool) {
+      // still on the pool after a suspension
+      await Task.yield()
+      return pool.isCurrent
+    }.value
+    XCTAssertTrue(onPool)
+  }
+
+  func testSpreadsWorkAcrossThreads() async {
+    let pool = FlutterHandlerThreadPool(threadCount: 4)
+    defer { pool.shutdown() }
+
+    let threads = await withTaskGroup(of: Int?.self) { group in
+      for _ in 0..<64 {
+        group.addTask(executorPreference: pool) {
+          // enough work that the other threads have to steal to keep up
+          var checksum: UInt64 = 0
+          for value in 0..<UInt64(20000) {
+            checksum = checksum &* 31 &+ value
+          }
+          return checksum != 0 ? pool.currentThreadIndex : nil
+        }
+      }
+      return await group.reduce(into: [Int?]()) { $0.append($1) }
+    }
+    XCTAssertEqual(threads.count, 64)
+    XCTAssertFalse(threads.contains(nil))
+    XCTAssertGreaterThan(Set(threads.compactMap { $0 }).count, 1)
+  }
+
+  func testStealsFromBusyThread() async {
+    let pool = FlutterHandlerThreadPool(threadCount: 2)
+    defer { pool.shutdown() }
+
+    let (parent, child, stolen) = await Task(executorPreference: pool) {
+      let ran = DispatchSemaphore(value: 0)
+      // enqueued from a pool thread, so onto that thread's own queue
+      let child = Task(executorPreference: pool) {
+        defer { ran.signal() }
+        return pool.currentThreadIndex
+      }
+      // hold this thread until another has taken the child from its queue
+      let stolen = ran.wait(timeout: .now() + 10) == .success
+      return (pool.currentThreadIndex, await child.value, stolen)
+    }.value
+    XCTAssertTrue(stolen)
+    XCTAssertNotNil(parent)
+    XCTAssertNotNil(child)
+    XCTAssertNotEqual(parent, child)
+  }
+
+  func testTaskOutlivesShutdown() async {
+    let pool = FlutterHandlerThreadPool(threadCount: 2)
+    let (stream, continuation) = AsyncStream.makeStream(of: Int.self)
+
+    let task = Task(executorPreference: pool) {
+      var values = stream.makeAsyncIterator()
+      // resumed after the pool's threads have gone
+      return await values.next()
+    }
+    pool.shutdown()
+    continuation.yield(1)
+    let value = await task.value
+    XCTAssertEqual(value, 1)
+  }
+
+  @FlutterPlatformThreadActor
+  func testMethodChannelHandlerRunsOnPool() async throws {
+    let pool = FlutterHandlerThreadPool(threadCount: 2)
+    defer { pool.shutdown() }
+
+    let channel = FlutterMethodChannel(
+      name: "pooled",
+      binaryMessenger: FlutterLoopbackMessenger(),
+      handlerExecutor: pool
+    )
+    try channel.setMethodCallHandler { (_: FlutterMethodCall<FlutterNull>) -> Bool? in
+      pool.isCurrent
+    }
+    let onPool: Bool? = try await channel.invoke(method: "where", arguments: FlutterNull?.none)
+    XCTAssertEqual(onPool, true)
+  }
+}
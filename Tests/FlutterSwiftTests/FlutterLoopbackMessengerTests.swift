@@ -0,0 +1,101 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import XCTest
+
+final class FlutterLoopbackMessengerTests: XCTestCase {
+  @FlutterPlatformThreadActor
+  func testMethodChannelRoundTrip() async throws {
+    let messenger = FlutterLoopbackMessenger()
+    let channel = FlutterMethodChannel(name: "echo", binaryMessenger: messenger)
+    try channel.setMethodCallHandler { (call: FlutterMethodCall<String>) -> String? in
+      guard call.method == "uppercase" else {
+        throw FlutterError(code: "unknown", message: call.method)
+      }
+      return call.arguments?.uppercased()
+    }
+
+    let reply: String? = try await channel.invoke(method: "uppercase", arguments: "abc")
+    XCTAssertEqual(reply, "ABC")
+    do {
+      let _: String? = try await channel.invoke(method: "lowercase", arguments: "ABC")
+      XCTFail("expected the handler's error")
+    } catch let error as FlutterError {
+      XCTAssertEqual(error.code, "unknown")
+    }
+  }
+
+  @FlutterPlatformThreadActor
+  func testBuffersUntilHandlerRegistered() async throws {
+    let messenger = FlutterLoopbackMessenger()
+    let channel = FlutterBasicMessageChannel(name: "buffered", binaryMessenger: messenger)
+    try channel.resizeChannelBuffer(2)
+    for value in Int32(0)..<3 {
+      try await channel.send(message: value)
+    }
+    XCTAssertEqual(messenger.bufferedMessageCount(on: "buffered"), 2)
+    XCTAssertEqual(messenger.discardedMessageCount, 1)
+
+    let (received, continuation) = AsyncStream.makeStream(of: Int32.self)
+    try channel.setMessageHandler { (message: Int32?) -> FlutterNull? in
+      continuation.yield(message ?? -1)
+      return nil
+    }
+    var values = Set<Int32>()
+    for await value in received {
+      values.insert(value)
+      if values.count == 2 { break }
+    }
+    // the oldest was the one discarded
+    XCTAssertEqual(values, [1, 2])
+    XCTAssertEqual(messenger.bufferedMessageCount(on: "buffered"), 0)
+  }
+
+  @FlutterPlatformThreadActor
+  func testDiscardedSenderIsRepliedToWithNil() async throws {
+    let messenger = FlutterLoopbackMessenger()
+    let first = Task {
+      try await messenger.send(on: "unhandled", message: Data([1]), priority: nil)
+    }
+    while messenger.bufferedMessageCount(on: "unhandled") == 0 {
+      await Task.yield()
+    }
+    // the default buffer holds one message, so this displaces the first
+    try messenger.send(on: "unhandled", message: Data([2]))
+
+    let reply = try await first.value
+    XCTAssertNil(reply)
+    XCTAssertEqual(messenger.discardedMessageCount, 1)
+    XCTAssertEqual(messenger.bufferedMessageCount(on: "unhandled"), 1)
+  }
+
+  @FlutterPlatformThreadActor
+  func testResizeDiscardsExcess() async throws {
+    let messenger = FlutterLoopbackMessenger()
+    let channel = FlutterBasicMessageChannel(name: "shrunk", binaryMessenger: messenger)
+    try channel.resizeChannelBuffer(3)
+    try channel.allowChannelBufferOverflow(true)
+    for value in Int32(0)..<3 {
+      try await channel.send(message: value)
+    }
+    XCTAssertEqual(messenger.discardedMessageCount, 0)
+
+    try channel.resizeChannelBuffer(0)
+    XCTAssertEqual(messenger.bufferedMessageCount(on: "shrunk"), 0)
+    XCTAssertEqual(messenger.discardedMessageCount, 3)
+  }
+}
@@ -107,4 +107,23 @@ final class FlutterMessageCodecTests: XCTestCase {
     let decoded: Composite = try codec.decode(encoded)
     XCTAssertEqual(decoded, value)
   }
+
+  // MARK: - borrowed decoding
+
+  func testStandardMessageCodecDecodesBorrowedBytes() throws {
+    let codec = FlutterStandardMessageCodec.shared
+    let value = Composite(before: 1, inner: Composite.Inner(value: 99), after: 7_834_868)
+    let encoded: Data = try codec.encode(value)
+    let decoded: Composite = try encoded.withUnsafeBytes { try codec.decode(borrowing: $0) }
+    XCTAssertEqual(decoded, value)
+  }
+
+  /// The default implementation copies, so it must agree with `decode(_:)`.
+  func testJSONMessageCodecDecodesBorrowedBytes() throws {
+    let codec = FlutterJSONMessageCodec.shared
+    let value = Simple(x: 1, y: 2, z: 3)
+    let encoded: Data = try codec.encode(value)
+    let decoded: Simple = try encoded.withUnsafeBytes { try codec.decode(borrowing: $0) }
+    XCTAssertEqual(decoded, value)
+  }
 }
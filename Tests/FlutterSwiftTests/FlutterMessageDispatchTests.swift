@@ -0,0 +1,144 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import Synchronization
+import XCTest
+
+private final class Occupancy: Sendable {
+  private let state = Mutex((current: 0, peak: 0, order: [Int32]()))
+
+  func enter(_ value: Int32) {
+    state.withLock {
+      $0.current += 1
+      $0.peak = max($0.peak, $0.current)
+      $0.order.append(value)
+    }
+  }
+
+  func leave() {
+    state.withLock { $0.current -= 1 }
+  }
+
+  var peak: Int { state.withLock { $0.peak } }
+  var order: [Int32] { state.withLock { $0.order } }
+}
+
+final class FlutterMessageDispatchTests: XCTestCase {
+  @FlutterPlatformThreadActor
+  private func roundTrip(
+    _ count: Int32,
+    dispatch: FlutterMessageDispatch
+  ) async throws -> Occupancy {
+    let messenger = FlutterLoopbackMessenger()
+    let channel = FlutterBasicMessageChannel(
+      name: "dispatched",
+      binaryMessenger: messenger,
+      dispatch: dispatch
+    )
+    let occupancy = Occupancy()
+    try channel.setMessageHandler { (message: Int32?) -> Int32? in
+      occupancy.enter(message ?? -1)
+      // later messages finish sooner, to show up any reordering
+      try? await Task.sleep(for: .microseconds(100 * Int(count - (message ?? 0))))
+      occupancy.leave()
+      return message
+    }
+
+    let codec = FlutterStandardMessageCodec.shared
+    try await withThrowingTaskGroup(of: Void.self) { group in
+      for value in 0..<count {
+        // the tasks run on the platform actor in the order they were created,
+        // and each delivers its message before it first suspends
+        let message = try codec.encode(value)
+        let reply = Task {
+          try await messenger.send(on: channel.name, message: message, priority: nil)
+        }
+        group.addTask {
+          let reply: Int32? = try await reply.value.map { try codec.decode($0) }
+          XCTAssertEqual(reply, value)
+        }
+      }
+      try await group.waitForAll()
+    }
+    return occupancy
+  }
+
+  func testSerialDispatchPreservesOrder() async throws {
+    let occupancy = try await roundTrip(16, dispatch: .serial())
+    XCTAssertEqual(occupancy.order, Array(0..<16))
+    XCTAssertEqual(occupancy.peak, 1)
+  }
+
+  func testBoundedConcurrency() async throws {
+    let occupancy = try await roundTrip(16, dispatch: .serial(maximumConcurrency: 3))
+    XCTAssertEqual(occupancy.order, Array(0..<16))
+    XCTAssertLessThanOrEqual(occupancy.peak, 3)
+  }
+
+  func testQueueDrainsAfterFinish() async {
+    let queue = _FlutterMessageQueue(maximumConcurrency: 1, priority: nil)
+    let (handled, continuation) = AsyncStream.makeStream(of: Int.self)
+    for value in 0..<3 {
+      queue.enqueue { continuation.yield(value) }
+    }
+    queue.finish()
+    // after finish, a late message is still run, on a task of its own
+    queue.enqueue { continuation.yield(3) }
+
+    var values = Set<Int>()
+    for await value in handled {
+      values.insert(value)
+      if values.count == 4 { break }
+    }
+    XCTAssertEqual(values, [0, 1, 2, 3])
+  }
+
+  /// A handler's captures — on eLinux, the engine's message buffer — are
+  /// released once it has run, not when the queue next compacts.
+  func testReleasesHandledJobs() async {
+    final class Message: Sendable {}
+    let queue = _FlutterMessageQueue(maximumConcurrency: 1, priority: nil)
+    defer { queue.finish() }
+
+    let (gate, open) = AsyncStream.makeStream(of: Void.self)
+    let (reached, reach) = AsyncStream.makeStream(of: Void.self)
+    // hold the worker until the rest are queued behind it
+    queue.enqueue {
+      var gate = gate.makeAsyncIterator()
+      await gate.next()
+    }
+    weak var released: Message?
+    do {
+      let message = Message()
+      released = message
+      queue.enqueue { withExtendedLifetime(message) {} }
+    }
+    queue.enqueue {
+      reach.yield()
+      var gate = gate.makeAsyncIterator()
+      await gate.next()
+    }
+    queue.enqueue {}
+
+    open.yield()
+    var iterator = reached.makeAsyncIterator()
+    await iterator.next()
+    // the handled job is gone, though a job is still queued behind this one
+    XCTAssertNil(released)
+    open.yield()
+  }
+}
@@ -0,0 +1,218 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import Synchronization
+import XCTest
+
+final class FlutterMessageSchedulerTests: XCTestCase {
+  private func makeScheduler() -> FlutterMessageScheduler {
+    // one slot shared by normal and bulk, and one kept for interactive
+    let scheduler = FlutterMessageScheduler(
+      maximumConcurrency: 2,
+      interactiveReserve: 1,
+      weights: [.interactive: 4, .normal: 2, .bulk: 1]
+    )
+    scheduler.classify("input", as: .interactive)
+    scheduler.classify("sync", as: .bulk)
+    return scheduler
+  }
+
+  func testInteractiveIsNotQueuedBehindBulk() async {
+    let scheduler = makeScheduler()
+    let (gate, open) = AsyncStream.makeStream(of: Void.self)
+    let (started, start) = AsyncStream.makeStream(of: String.self)
+
+    scheduler.schedule({
+      start.yield("blocker")
+      for await _ in gate { break }
+    }, on: "sync", priority: nil)
+    for _ in 0..<5 {
+      scheduler.schedule({ start.yield("sync") }, on: "sync", priority: nil)
+    }
+    scheduler.schedule({ start.yield("input") }, on: "input", priority: nil)
+
+    var iterator = started.makeAsyncIterator()
+    var first = Set<String>()
+    for _ in 0..<2 {
+      if let label = await iterator.next() {
+        first.insert(label)
+      }
+    }
+    XCTAssertEqual(first, ["blocker", "input"])
+    XCTAssertEqual(scheduler.queueDepth(.bulk), 5)
+
+    open.yield()
+    for _ in 0..<5 {
+      let label = await iterator.next()
+      XCTAssertEqual(label, "sync")
+    }
+    let snapshot = scheduler.snapshot()
+    XCTAssertEqual(snapshot[.bulk]?.maximumQueueDepth, 5)
+    XCTAssertEqual(snapshot[.bulk]?.dispatched, 6)
+    XCTAssertEqual(snapshot[.interactive]?.dispatched, 1)
+    XCTAssertEqual(snapshot[.interactive]?.waitTime.count, 1)
+  }
+
+  func testWeightedFairQueuing() async {
+    let scheduler = makeScheduler()
+    let (gate, open) = AsyncStream.makeStream(of: Void.self)
+    let (started, start) = AsyncStream.makeStream(of: String.self)
+
+    scheduler.schedule({ for await _ in gate { break } }, on: "sync", priority: nil)
+    for _ in 0..<3 {
+      scheduler.schedule({ start.yield("bulk") }, on: "sync", priority: nil)
+    }
+    for _ in 0..<3 {
+      scheduler.schedule({ start.yield("normal") }, on: "settings", priority: nil)
+    }
+    open.yield()
+
+    var order = [String]()
+    for await label in started {
+      order.append(label)
+      if order.count == 6 { break }
+    }
+    // normal has twice bulk's weight, so its messages are started twice as
+    // often while both are queued, though bulk's were queued first
+    XCTAssertEqual(order, ["normal", "normal", "bulk", "normal", "bulk", "bulk"])
+  }
+
+  @FlutterPlatformThreadActor
+  func testMessengerSchedulesHandlers() async throws {
+    let scheduler = makeScheduler()
+    let messenger = FlutterLoopbackMessenger()
+    messenger.scheduler = scheduler
+    let channel = FlutterBasicMessageChannel(name: "input", binaryMessenger: messenger)
+    try channel.setMessageHandler { (message: String?) -> String? in message }
+
+    let reply = try await channel.send(message: "tap", reply: String.self)
+    XCTAssertEqual(reply, "tap")
+    XCTAssertEqual(scheduler.snapshot()[.interactive]?.dispatched, 1)
+  }
+
+  /// Floods the bulk class with handlers that hold their slots, as suspended
+  /// ones do, and checks that no bulk message starts ahead of an interactive
+  /// one sent meanwhile: first while the reserved slot is free, then while it
+  /// too is held, so that interactive messages contend for the shared slots.
+  func testInteractiveIsServedAheadOfBulkFlood() async throws {
+    let scheduler = FlutterMessageScheduler(maximumConcurrency: 4, interactiveReserve: 1)
+    scheduler.classify("input", as: .interactive)
+    scheduler.classify("sync", as: .bulk)
+    let bulkHolders = SlotHolders(), inputHolders = SlotHolders()
+    let (started, start) = AsyncStream.makeStream(of: String.self)
+    var starts = started.makeAsyncIterator()
+
+    let bulkCount = 200
+    for _ in 0..<bulkCount {
+      scheduler.schedule({
+        start.yield("bulk")
+        await bulkHolders.hold()
+      }, on: "sync", priority: nil)
+    }
+    for _ in 0..<3 {
+      let label = await starts.next()
+      XCTAssertEqual(label, "bulk")
+    }
+    XCTAssertEqual(scheduler.queueDepth(.bulk), bulkCount - 3)
+
+    // every shared slot is held, so only the reserve lets these start
+    for _ in 0..<10 {
+      scheduler.schedule({ start.yield("input") }, on: "input", priority: nil)
+      let label = await starts.next()
+      XCTAssertEqual(label, "input")
+    }
+
+    scheduler.schedule({
+      start.yield("held input")
+      await inputHolders.hold()
+    }, on: "input", priority: nil)
+    let held = await starts.next()
+    XCTAssertEqual(held, "held input")
+
+    // each slot a bulk handler frees goes to the waiting interactive message,
+    // and only the slot that one frees in turn to the next bulk message
+    for _ in 0..<10 {
+      scheduler.schedule({ start.yield("input") }, on: "input", priority: nil)
+      XCTAssertEqual(scheduler.queueDepth(.interactive), 1)
+      bulkHolders.releaseOldest()
+      let first = await starts.next()
+      let second = await starts.next()
+      XCTAssertEqual([first, second], ["input", "bulk"])
+    }
+
+    bulkHolders.releaseAll()
+    inputHolders.releaseAll()
+    var bulkStarted = 3 + 10
+    while bulkStarted < bulkCount, let label = await starts.next() {
+      if label == "bulk" { bulkStarted += 1 }
+    }
+    let snapshot = scheduler.snapshot()
+    XCTAssertEqual(snapshot[.interactive]?.dispatched, 21)
+    XCTAssertEqual(snapshot[.bulk]?.dispatched, bulkCount)
+    XCTAssertGreaterThan(snapshot[.bulk]?.maximumQueueDepth ?? 0, 100)
+  }
+}
+
+/// Handlers that hold their slots until released, oldest first. A release
+/// that finds no holder yet lets the next one through.
+private final class SlotHolders: Sendable {
+  private struct State {
+    var waiting = [CheckedContinuation<Void, Never>]()
+    var releases = 0
+    var isReleased = false
+  }
+
+  private let state = Mutex(State())
+
+  func hold() async {
+    await withCheckedContinuation { continuation in
+      let isReleased = state.withLock { state in
+        if state.isReleased { return true }
+        if state.releases > 0 {
+          state.releases -= 1
+          return true
+        }
+        state.waiting.append(continuation)
+        return false
+      }
+      if isReleased { continuation.resume() }
+    }
+  }
+
+  func releaseOldest() {
+    let oldest = state.withLock { state in
+      guard !state.waiting.isEmpty else {
+        state.releases += 1
+        return nil
+      }
+      return state.waiting.removeFirst()
+    }
+    oldest?.resume()
+  }
+
+  /// Releases every holder, now and from now on.
+  func releaseAll() {
+    let waiting = state.withLock { state in
+      state.isReleased = true
+      defer { state.waiting.removeAll() }
+      return state.waiting
+    }
+    for continuation in waiting {
+      continuation.resume()
+    }
+  }
+}
@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#if os(Linux) && canImport(Glibc)
+@testable import FlutterSwift
+import Glibc
+import XCTest
+
+/// Plays the Dart side of a shared-memory channel: attaches, maps the ring,
+/// and reads each payload a descriptor names.
+@FlutterPlatformThreadActor
+private final class MappingMessenger: FlutterBinaryMessenger {
+  var handler: FlutterBinaryMessageHandler?
+  var mapping: UnsafeRawBufferPointer?
+  var payloads = [Data]()
+  var descriptors = [[Int64]]()
+  /// Whether replies to `data` wait for `reply()`, as from a slow reader.
+  var holdsReplies = false
+  private var heldReplies = [CheckedContinuation<(), Never>]()
+
+  private let codec = FlutterStandardMessageCodec.shared
+
+  func attach() async throws {
+    let call = FlutterMethodCall<FlutterNull>(method: "attach", arguments: nil)
+    let reply = try await handler!(codec.encode(call))
+    let envelope: FlutterEnvelope<[Int64]> = try codec.decode(XCTUnwrap(reply))
+    guard case let .success(attachment) = envelope, let attachment else {
+      XCTFail("attach failed")
+      return
+    }
+    let capacity = Int(attachment[1])
+    let address = mmap(nil, capacity, PROT_READ, MAP_SHARED, CInt(attachment[0]), 0)
+    mapping = UnsafeRawBufferPointer(start: address, count: capacity)
+  }
+
+  /// Replies to the oldest `data` call still held.
+  func reply() {
+    heldReplies.removeFirst().resume()
+  }
+
+  /// Yields until `count` descriptors have arrived.
+  func awaitDescriptors(_ count: Int) async {
+    while descriptors.count < count {
+      await Task.yield()
+    }
+  }
+
+  func detach() {
+    guard let mapping else { return }
+    munmap(UnsafeMutableRawPointer(mutating: mapping.baseAddress), mapping.count)
+  }
+
+  func send(on channel: String, message: Data?) throws {}
+
+  func send(on channel: String, message: Data?, priority: TaskPriority?) async throws -> Data? {
+    let call: FlutterMethodCall<[Int64]> = try codec.decode(XCTUnwrap(message))
+    let descriptor = try XCTUnwrap(call.arguments)
+    XCTAssertEqual(call.method, "data")
+    descriptors.append(descriptor)
+    let offset = Int(descriptor[1])
+    payloads.append(Data(try XCTUnwrap(mapping)[offset..<offset + Int(descriptor[2])]))
+    if holdsReplies {
+      await withCheckedContinuation { heldReplies.append($0) }
+    }
+    return try codec.encode(FlutterEnvelope<FlutterNull>(nil))
+  }
+
+  nonisolated func setMessageHandler(
+    on channel: String,
+    handler: FlutterBinaryMessageHandler?,
+    priority: TaskPriority?
+  ) throws -> FlutterBinaryMessengerConnection {
+    MainActor.assumeIsolated { self.handler = handler }
+    return 1
+  }
+
+  nonisolated func cleanUp(connection: FlutterBinaryMessengerConnection) throws {}
+}
+
+final class FlutterSharedMemoryChannelTests: XCTestCase {
+  func testRingWrapsAndReclaimsInOrder() throws {
+    var ring = FlutterSharedMemoryRing(capacity: 100)
+    let first = try XCTUnwrap(ring.reserve(40))
+    let second = try XCTUnwrap(ring.reserve(40))
+    XCTAssertEqual(first.offset, 0)
+    XCTAssertEqual(second.offset, 40)
+    XCTAssertEqual(second.sequence, 1)
+    // 20 bytes free, none of them at the start
+    XCTAssertNil(ring.reserve(30))
+
+    // the second payload's space waits for the first
+    _ = ring.release(second.sequence)
+    XCTAssertNil(ring.reserve(30))
+    _ = ring.release(first.sequence)
+
+    // does not fit in the 20 bytes at the end, so starts the ring again
+    let third = try XCTUnwrap(ring.reserve(30))
+    XCTAssertEqual(third.offset, 0)
+    XCTAssertEqual(try XCTUnwrap(ring.reserve(50)).offset, 30)
+    // the ring was empty before the third, so the 20 bytes after it are free
+    XCTAssertEqual(try XCTUnwrap(ring.reserve(20)).offset, 80)
+    XCTAssertNil(ring.reserve(1))
+  }
+
+  func testDrainedRingTakesFullCapacity() throws {
+    var ring = FlutterSharedMemoryRing(capacity: 4096)
+    let small = try XCTUnwrap(ring.reserve(1))
+    _ = ring.release(small.sequence)
+
+    // would otherwise fit neither after the byte just released nor before it
+    let full = try XCTUnwrap(ring.reserve(4096))
+    XCTAssertEqual(full.offset, 0)
+    XCTAssertNil(ring.reserve(1))
+    _ = ring.release(full.sequence)
+    XCTAssertEqual(try XCTUnwrap(ring.reserve(4096)).offset, 0)
+  }
+
+  @FlutterPlatformThreadActor
+  func testPayloadsAreReadFromSharedMemory() async throws {
+    let messenger = MappingMessenger()
+    let channel = try FlutterSharedMemoryChannel(
+      name: "bulk",
+      binaryMessenger: messenger,
+      capacity: 4096
+    )
+    try await messenger.attach()
+    defer { messenger.detach() }
+
+    let payloads = (0..<5).map { Data(repeating: UInt8($0), count: 1000 + $0) }
+    for payload in payloads {
+      try await channel.send(payload)
+    }
+    try await channel.send(byteCount: 3) { bytes in
+      bytes.copyBytes(from: [1, 2, 3])
+    }
+
+    XCTAssertEqual(messenger.payloads, payloads + [Data([1, 2, 3])])
+    XCTAssertEqual(messenger.descriptors.map(\.[0]), [0, 1, 2, 3, 4, 5])
+    // each payload was released once read, so the fifth wrapped to the start
+    XCTAssertEqual(messenger.descriptors[4][1], 0)
+
+    do {
+      try await channel.send(Data(count: 4097))
+      XCTFail("expected a payload larger than the ring to be refused")
+    } catch {
+      XCTAssertEqual(error as? FlutterSwiftError, .variableSizedTypeTooBig)
+    }
+  }
+
+  @FlutterPlatformThreadActor
+  func testFullRingWaitsForRepliesInOrder() async throws {
+    let messenger = MappingMessenger()
+    messenger.holdsReplies = true
+    let channel = try FlutterSharedMemoryChannel(
+      name: "full",
+      binaryMessenger: messenger,
+      capacity: 4096
+    )
+    try await messenger.attach()
+    defer { messenger.detach() }
+
+    let large = Data(repeating: 2, count: 3000)
+    let small = Data(repeating: 3, count: 500)
+    let first = Task { try await channel.send(Data(repeating: 1, count: 3000)) }
+    await messenger.awaitDescriptors(1)
+    // the ring is full until the first payload is replied to
+    let second = Task { try await channel.send(large) }
+    for _ in 0..<100 {
+      await Task.yield()
+    }
+    // this one would fit now, but queues behind the larger one waiting
+    let third = Task { try await channel.send(small) }
+    for _ in 0..<100 {
+      await Task.yield()
+    }
+    XCTAssertEqual(messenger.descriptors.count, 1)
+
+    messenger.reply()
+    try await first.value
+    await messenger.awaitDescriptors(2)
+    XCTAssertEqual(messenger.payloads[1], large)
+    XCTAssertEqual(messenger.descriptors[1][1], 0)
+
+    messenger.reply()
+    try await second.value
+    await messenger.awaitDescriptors(3)
+    XCTAssertEqual(messenger.payloads[2], small)
+    messenger.reply()
+    try await third.value
+    XCTAssertEqual(messenger.descriptors.map(\.[0]), [0, 1, 2])
+  }
+}
+#endif
@@ -0,0 +1,126 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import Foundation
+import XCTest
+
+/// Covers `FlutterStandardBufferPool` and the encoder's use of it.
+///
+/// Reuse is checked through the buffer's storage address: a reallocation, or a
+/// copy-on-write caused by the buffer being shared while it is written, would
+/// move it. The allocations the pool does not remove are counted by the
+/// `mallocCountTotal` thresholds in Benchmarks.
+final class FlutterStandardBufferPoolTests: XCTestCase {
+  private let fixedShapes: [any Encodable] = [
+    Composite(before: 1, inner: Composite.Inner(value: 99), after: 7_834_868),
+    FlutterMethodCall(method: "update", arguments: [Int32(1), 2, 3]),
+    AnyFlutterStandardCodable.map([.string("x"): .float64(1.5), .string("y"): .int32Data([1, 2])]),
+    FlutterEnvelope.success(AnyFlutterStandardCodable.float64(0.25)),
+  ]
+
+  func testCodablePathWritesIntoRecycledCapacity() throws {
+    let encoder = FlutterStandardEncoder()
+
+    for value in fixedShapes {
+      var buffer = [UInt8]()
+      try encoder.encode(value, into: &buffer)
+      let storage = buffer.withUnsafeBufferPointer { $0.baseAddress }
+
+      for _ in 0..<1000 {
+        buffer.removeAll(keepingCapacity: true)
+        try encoder.encode(value, into: &buffer)
+        XCTAssertEqual(buffer.withUnsafeBufferPointer { $0.baseAddress }, storage)
+      }
+    }
+  }
+
+  func testPooledEncodingReusesOneBuffer() throws {
+    let pool = FlutterStandardBufferPool(maximumCount: 1)
+    let encoder = FlutterStandardEncoder(bufferPool: pool)
+
+    for value in fixedShapes {
+      let expected = try FlutterStandardEncoder(bufferPool: FlutterStandardBufferPool())
+        .encode(value)
+      var storage: UnsafePointer<UInt8>?
+
+      for iteration in 0..<1000 {
+        let address = try pool.withBuffer { buffer in
+          try encoder.encode(value, into: &buffer)
+          XCTAssertEqual(Data(buffer), expected)
+          return buffer.withUnsafeBufferPointer { $0.baseAddress }
+        }
+        if iteration == 0 {
+          storage = address
+        } else {
+          XCTAssertEqual(address, storage)
+        }
+      }
+      XCTAssertEqual(pool.idleCount, 1)
+    }
+  }
+
+  /// A pooled buffer is emptied before reuse, so one message's bytes cannot
+  /// leak into the next — in particular into its alignment padding, which is
+  /// measured from the start of the buffer.
+  func testPooledEncodingMatchesFreshEncoding() throws {
+    let pool = FlutterStandardBufferPool()
+    let encoder = FlutterStandardEncoder(bufferPool: pool)
+
+    for value in fixedShapes + fixedShapes.reversed() {
+      let expected = try FlutterStandardEncoder(bufferPool: FlutterStandardBufferPool())
+        .encode(value)
+      XCTAssertEqual(try encoder.encode(value), expected)
+    }
+  }
+
+  func testPoolDropsOversizedBuffers() {
+    let pool = FlutterStandardBufferPool(maximumCount: 2, maximumCapacity: 64)
+
+    pool.withBuffer { $0.reserveCapacity(1024) }
+    XCTAssertEqual(pool.idleCount, 0)
+
+    pool.withBuffer { $0.reserveCapacity(16) }
+    XCTAssertEqual(pool.idleCount, 1)
+  }
+
+  func testOversizedBufferIsAdoptedNotCopied() throws {
+    let pool = FlutterStandardBufferPool(maximumCapacity: 64)
+    let value = AnyFlutterStandardCodable.uint8Data(Array(repeating: 7, count: 1024))
+    let expected = try FlutterStandardEncoder(bufferPool: FlutterStandardBufferPool()).encode(value)
+
+    let (data, storage) = try pool.withBuffer { buffer in
+      try FlutterStandardEncoder().encode(value, into: &buffer)
+      return (pool.data(from: buffer), buffer.withUnsafeBufferPointer { $0.baseAddress })
+    }
+    XCTAssertEqual(data, expected)
+    // the Data shares the buffer's storage, rather than a copy of it
+    let bytes = data.withUnsafeBytes { $0.baseAddress?.assumingMemoryBound(to: UInt8.self) }
+    XCTAssertEqual(bytes, storage)
+    XCTAssertEqual(pool.idleCount, 0)
+  }
+
+  func testPoolKeepsAtMostMaximumCount() {
+    let pool = FlutterStandardBufferPool(maximumCount: 2)
+
+    pool.withBuffer { _ in
+      pool.withBuffer { _ in
+        pool.withBuffer { _ in }
+      }
+    }
+    XCTAssertEqual(pool.idleCount, 2)
+  }
+}
@@ -40,6 +40,42 @@ final class FlutterStandardDecoderErrorTests: XCTestCase {
     )
   }
 
+  /// Fixed-size scalars are read in place rather than through a `ParserSpan`,
+  /// so they have to raise the errors the span would have.
+  func testScalarErrorsMatchParser() throws {
+    let decoder = FlutterStandardDecoder()
+
+    let int32Cases: [([UInt8], FlutterSwiftError)] = [
+      ([0x03, 0x01, 0x02], .eofTooEarly),
+      ([0x07, 0x01, 0x61], .unexpectedStandardFieldType(.string)),
+      ([0xFF, 0x00, 0x00, 0x00, 0x00], .unknownStandardFieldType(0xFF)),
+    ]
+    for (bytes, expected) in int32Cases {
+      XCTAssertThrowsError(try decoder.decode(Int32.self, from: Data(bytes))) { error in
+        XCTAssertEqual(error as? FlutterSwiftError, expected, "for \(bytes)")
+      }
+    }
+
+    let float64Cases: [([UInt8], FlutterSwiftError)] = [
+      // 7 bytes of padding are due but only 3 remain
+      ([0x06, 0x00, 0x00, 0x00], .invalidAlignment),
+      // padding present, payload short
+      ([0x06, 0, 0, 0, 0, 0, 0, 0, 0x01], .eofTooEarly),
+    ]
+    for (bytes, expected) in float64Cases {
+      XCTAssertThrowsError(try decoder.decode(Double.self, from: Data(bytes))) { error in
+        XCTAssertEqual(error as? FlutterSwiftError, expected, "for \(bytes)")
+      }
+    }
+
+    // and inside a list, whose elements no longer go through a container
+    XCTAssertThrowsError(
+      try decoder.decode([Bool].self, from: Data([0x0C, 0x02, 0x01]))
+    ) { error in
+      XCTAssertEqual(error as? FlutterSwiftError, .eofTooEarly)
+    }
+  }
+
   func testDecodeEmptyData() throws {
     let decoder = FlutterStandardDecoder()
     // Empty data should decode to nil optional
@@ -169,6 +169,63 @@ final class FlutterStandardDecoderTests: XCTestCase {
     XCTAssertEqual(try decodeFromSlice([Int32(1), -2, 3, -4]), [1, -2, 3, -4])
   }
 
+  /// A `FlutterStandardDecodable` conformance replaces the synthesized
+  /// `Decodable` one wherever the standard decoder meets the type, so both have
+  /// to read the same bytes to the same value.
+  func testFlutterStandardDecodableMatchesCodable() throws {
+    let encoder = FlutterStandardEncoder()
+    let decoder = FlutterStandardDecoder()
+
+    for value in WindowArguments.samples {
+      let encoded = try encoder.encode(value)
+      XCTAssertEqual(try decoder.decode(WindowArguments.self, from: encoded), value)
+
+      let viaCodable = try encoded.withUnsafeBytes { bytes in
+        let state = FlutterStandardDecodingState(bytes: bytes)
+        return try WindowArguments(from: FlutterStandardDecoderImpl(state: state, codingPath: []))
+      }
+      XCTAssertEqual(viaCodable, value)
+    }
+  }
+
+  /// Nested inside a `Decodable` graph the conformance is found by the decoding
+  /// state, which has to resume from where the parse left off.
+  func testFlutterStandardDecodableNestedInCodable() throws {
+    let encoder = FlutterStandardEncoder()
+    let decoder = FlutterStandardDecoder()
+
+    let list = WindowArguments.samples
+    XCTAssertEqual(try decoder.decode([WindowArguments].self, from: encoder.encode(list)), list)
+
+    let generic = Generic(value: WindowArguments.samples[1], additional: 7)
+    XCTAssertEqual(
+      try decoder.decode(Generic<WindowArguments>.self, from: encoder.encode(generic)),
+      generic
+    )
+  }
+
+  /// The fast path fails where the `Decodable` path does, with the same error.
+  func testFlutterStandardDecodableReportsErrors() throws {
+    let decoder = FlutterStandardDecoder()
+    let encoded = try FlutterStandardEncoder().encode(WindowArguments.samples[0])
+
+    // the first field is an int64; claim it is a string instead
+    var mistyped = [UInt8](encoded)
+    mistyped[0] = FlutterStandardField.string.rawValue
+    try assertThat(
+      decoder,
+      whileDecoding: WindowArguments.self,
+      from: mistyped,
+      throws: .unexpectedStandardFieldType(.string)
+    )
+    try assertThat(
+      decoder,
+      whileDecoding: WindowArguments.self,
+      from: [UInt8](encoded.prefix(encoded.count - 1)),
+      throws: .eofTooEarly
+    )
+  }
+
   private func assertThat<Value>(
     _ decoder: FlutterStandardDecoder,
     decodes array: [UInt8],
@@ -479,6 +479,41 @@ final class FlutterStandardEncoderTests: XCTestCase {
     try assertThat(encoder: encoder, decoder: decoder, canEncodeDecode: UInt(Int.max))
   }
 
+  /// A `FlutterStandardEncodable` conformance replaces the synthesized
+  /// `Encodable` one wherever the standard codec meets the type, so the two
+  /// have to agree byte for byte — including alignment, which the `Double`
+  /// after an odd-sized prefix exercises.
+  func testFlutterStandardEncodableMatchesCodable() throws {
+    let encoder = FlutterStandardEncoder()
+
+    for value in WindowArguments.samples {
+      let viaWriter = try encoder.encode(value)
+      let state = FlutterStandardEncodingState()
+      try value.encode(to: FlutterStandardEncoderImpl(state: state, codingPath: []))
+      XCTAssertEqual([UInt8](viaWriter), [UInt8](state.data), "diverged for \(value)")
+    }
+  }
+
+  /// Nested inside a `Codable` graph the conformance is found by the encoding
+  /// state rather than the top-level encoder; what it writes has to read back
+  /// through the `Decodable` conformance.
+  func testFlutterStandardEncodableNestedInCodable() throws {
+    let encoder = FlutterStandardEncoder()
+    let decoder = FlutterStandardDecoder()
+
+    try assertThat(encoder: encoder, decoder: decoder, canEncodeDecode: WindowArguments.samples)
+    try assertThat(
+      encoder: encoder,
+      decoder: decoder,
+      canEncodeDecode: Generic(value: WindowArguments.samples[1], additional: 7)
+    )
+    try assertThat(
+      encoder: encoder,
+      decoder: decoder,
+      canEncodeDecode: ["a": WindowArguments.samples[0]]
+    )
+  }
+
   private func assertThat<Value>(
     encoder: FlutterStandardEncoder,
     decoder: FlutterStandardDecoder,
@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import XCTest
+
+/// Covers encoding from caller-owned buffers: the borrowed typed-data writes on
+/// `FlutterStandardWriter`, and scatter-gather output from
+/// `FlutterStandardMessageCodec.encodeSegments(_:minimumSegmentSize:)`.
+final class FlutterStandardSegmentTests: XCTestCase {
+  private struct Frame: Codable {
+    let id: Int32
+    let blob: Data
+    let samples: FlutterStandardTypedArray<Float>
+    let trailer: Double
+  }
+
+  /// Writes `values` from each kind of borrowed source in turn.
+  private struct BorrowedSamples: Codable, FlutterStandardEncodable {
+    let values: [Double]
+
+    func write(to writer: inout FlutterStandardWriter) throws(FlutterSwiftError) {
+      try writer.writeListHeader(count: 3)
+      try writer.write(values.span)
+      let buffer = UnsafeMutableBufferPointer<Double>.allocate(capacity: values.count)
+      defer { buffer.deallocate() }
+      _ = buffer.initialize(from: values)
+      try writer.write(UnsafeBufferPointer(buffer))
+      try writer.write(UnsafeRawBufferPointer(buffer), as: Double.self)
+    }
+
+    func encode(to encoder: any Encoder) throws {
+      var container = encoder.unkeyedContainer()
+      for _ in 0..<3 {
+        try container.encode(values)
+      }
+    }
+  }
+
+  // odd sizes, so that neither payload is a multiple of the alignment
+  private let frame = Frame(
+    id: 7,
+    blob: Data((0..<100_003).map { UInt8(truncatingIfNeeded: $0) }),
+    samples: FlutterStandardTypedArray((0..<10001).map { Float($0) }),
+    trailer: 0.25
+  )
+
+  func testBorrowedSourcesMatchArrays() throws {
+    let values = [1.5, -2.25, 1e300]
+    let encoder = FlutterStandardEncoder()
+    XCTAssertEqual(
+      try encoder.encode(BorrowedSamples(values: values)),
+      try encoder.encode([values, values, values])
+    )
+  }
+
+  func testRawSourceMustHoldWholeElements() throws {
+    struct Ragged: Codable, FlutterStandardEncodable {
+      func write(to writer: inout FlutterStandardWriter) throws(FlutterSwiftError) {
+        let bytes = UnsafeMutableRawBufferPointer.allocate(byteCount: 6, alignment: 4)
+        defer { bytes.deallocate() }
+        bytes.initializeMemory(as: UInt8.self, repeating: 0)
+        try writer.write(UnsafeRawBufferPointer(bytes), as: Int32.self)
+      }
+    }
+    XCTAssertThrowsError(try FlutterStandardEncoder().encode(Ragged())) { error in
+      XCTAssertEqual(error as? FlutterSwiftError, .fieldNotEncodable)
+    }
+  }
+
+  func testSegmentsConcatenateToMessage() throws {
+    let codec = FlutterStandardMessageCodec()
+    let segments = try codec.encodeSegments(frame, minimumSegmentSize: 1024)
+
+    XCTAssertEqual(segments.reduce(Data(), +), try codec.encode(frame))
+    // header, blob, between, samples, trailer
+    XCTAssertEqual(segments.count, 5)
+    let decoded: Frame = try codec.decode(segments.reduce(Data(), +))
+    XCTAssertEqual(decoded.blob, frame.blob)
+    XCTAssertEqual(decoded.samples, frame.samples)
+    XCTAssertEqual(decoded.trailer, frame.trailer)
+  }
+
+  func testSegmentsShareStorage() throws {
+    let segments = try FlutterStandardMessageCodec()
+      .encodeSegments(frame, minimumSegmentSize: 1024)
+
+    func address(_ data: Data) -> UnsafeRawPointer? {
+      data.withUnsafeBytes { $0.baseAddress }
+    }
+    XCTAssertEqual(address(segments[1]), address(frame.blob))
+    XCTAssertEqual(segments[1].count, 100_000)
+    frame.samples.withUnsafeBufferPointer { samples in
+      XCTAssertEqual(address(segments[3]), UnsafeRawPointer(samples.baseAddress))
+    }
+  }
+
+  func testSmallPayloadsAreNotGathered() throws {
+    let codec = FlutterStandardMessageCodec()
+    let segments = try codec.encodeSegments(frame, minimumSegmentSize: 1 << 20)
+    XCTAssertEqual(segments, [try codec.encode(frame)])
+
+    XCTAssertEqual(try codec.encodeSegments(FlutterNull?.none), [Data([0x00])])
+  }
+
+  func testAdoptedData() throws {
+    let bytes = Data(repeating: 0x3F, count: 4096)
+    let samples = try XCTUnwrap(FlutterStandardTypedArray<Float>(data: bytes))
+    XCTAssertEqual(samples.count, 1024)
+    XCTAssertNil(FlutterStandardTypedArray<Double>(data: bytes.prefix(12)))
+
+    let segments = try FlutterStandardMessageCodec()
+      .encodeSegments(samples, minimumSegmentSize: 1024)
+    XCTAssertEqual(segments.count, 2)
+    XCTAssertEqual(
+      segments[1].withUnsafeBytes { $0.baseAddress },
+      bytes.withUnsafeBytes { $0.baseAddress }
+    )
+  }
+}
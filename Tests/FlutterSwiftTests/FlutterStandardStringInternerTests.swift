@@ -0,0 +1,102 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import XCTest
+
+final class FlutterStandardStringInternerTests: XCTestCase {
+  /// Long enough not to be stored inline, so that sharing is observable.
+  private let longKey = "devicePixelRatioForPrimaryView"
+
+  private func message(_ keys: [String]) -> AnyFlutterStandardCodable {
+    .map(Dictionary(uniqueKeysWithValues: keys.enumerated().map {
+      (.string($0.element), .int32(Int32($0.offset)))
+    }))
+  }
+
+  private func storage(of string: String) -> UnsafePointer<UInt8>? {
+    var string = string
+    return string.withUTF8 { $0.baseAddress }
+  }
+
+  func testRepeatedKeysShareStorage() throws {
+    let interner = FlutterStandardStringInterner()
+    let codec = FlutterStandardMessageCodec(stringInterner: interner)
+    let data = try codec.encode(message([longKey, "x", "y"]))
+
+    let first: AnyFlutterStandardCodable = try codec.decode(data)
+    XCTAssertEqual(interner.count, 3)
+    let second: AnyFlutterStandardCodable = try codec.decode(data)
+    XCTAssertEqual(interner.count, 3)
+
+    func key(in value: AnyFlutterStandardCodable) throws -> String {
+      guard case let .map(map) = value,
+            case let .string(key) = try XCTUnwrap(map.keys.first { $0 == .string(longKey) })
+      else {
+        XCTFail("expected a map containing \(longKey)")
+        return ""
+      }
+      return key
+    }
+    XCTAssertEqual(try storage(of: key(in: first)), try storage(of: key(in: second)))
+  }
+
+  func testInterningDoesNotChangeDecodedValues() throws {
+    let codec = FlutterStandardMessageCodec(stringInterner: FlutterStandardStringInterner())
+    let value: AnyFlutterStandardCodable = .list([
+      message([longKey, "a", "\u{263A}"]),
+      .map([.string("nested"): message(["a", "b"]), .int32(1): .string("value")]),
+    ])
+    let data = try codec.encode(value)
+
+    XCTAssertEqual(try codec.decode(data) as AnyFlutterStandardCodable, value)
+    XCTAssertEqual(
+      try codec.decode(data) as AnyFlutterStandardCodable,
+      try FlutterStandardMessageCodec.shared.decode(data) as AnyFlutterStandardCodable
+    )
+  }
+
+  func testCodableMapsAreInterned() throws {
+    let interner = FlutterStandardStringInterner()
+    let codec = FlutterStandardMessageCodec(stringInterner: interner)
+    let value = [longKey: 1.5, "scale": 2.0]
+    let data = try codec.encode(value)
+
+    for _ in 0..<3 {
+      XCTAssertEqual(try codec.decode(data) as [String: Double], value)
+    }
+    XCTAssertEqual(interner.count, 2)
+  }
+
+  func testLimits() throws {
+    let interner = FlutterStandardStringInterner(maximumCount: 2, maximumLength: 8)
+    let codec = FlutterStandardMessageCodec(stringInterner: interner)
+    let value = message(["a", "b", "c", "toolongforthetable"])
+    let data = try codec.encode(value)
+
+    XCTAssertEqual(try codec.decode(data) as AnyFlutterStandardCodable, value)
+    XCTAssertEqual(interner.count, 2)
+  }
+
+  func testInvalidKeyThrows() throws {
+    let codec = FlutterStandardMessageCodec(stringInterner: FlutterStandardStringInterner())
+    // map of one entry, whose key is the lone byte 0xFF
+    let data = Data([0x0D, 0x01, 0x07, 0x01, 0xFF, 0x00])
+    XCTAssertThrowsError(try codec.decode(data) as AnyFlutterStandardCodable) { error in
+      XCTAssertEqual(error as? FlutterSwiftError, .stringNotDecodable(Data([0xFF])))
+    }
+  }
+}
@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import XCTest
+
+final class FlutterStandardTypedArrayTests: XCTestCase {
+  private struct PointCloud: Codable, Equatable {
+    let name: String
+    let points: FlutterStandardTypedArray<Float>
+    let timestamps: FlutterStandardTypedArray<Int64>
+  }
+
+  private let points: [Float] = (0..<1000).map { Float($0) * 0.5 }
+
+  func testDecodesInPlace() throws {
+    let data = try FlutterStandardEncoder().encode(points)
+    let value = try FlutterStandardDecoder()
+      .decode(FlutterStandardTypedArray<Float>.self, from: data)
+
+    XCTAssertTrue(value.isSharingMessageStorage)
+    XCTAssertEqual(Array(value), points)
+    value.withSpan { span in
+      XCTAssertEqual(span.count, points.count)
+      XCTAssertEqual(span[999], 499.5)
+    }
+    // the elements are read where they lie in the message
+    data.withUnsafeBytes { message in
+      value.withUnsafeBufferPointer { elements in
+        XCTAssertEqual(
+          UnsafeRawPointer(elements.baseAddress),
+          message.baseAddress.map { $0 + message.count - points.count * 4 }
+        )
+      }
+    }
+  }
+
+  func testCopiesWhenMisaligned() throws {
+    // a message whose storage starts one byte into an allocation
+    let data = try Data([0xFF]) + FlutterStandardEncoder().encode(points)
+    let message = data[1...]
+    let value = try FlutterStandardDecoder()
+      .decode(FlutterStandardTypedArray<Float>.self, from: message)
+
+    XCTAssertFalse(value.isSharingMessageStorage)
+    XCTAssertEqual(Array(value), points)
+    value.withSpan { XCTAssertEqual($0[1], 0.5) }
+  }
+
+  func testCopiesBorrowedBytes() throws {
+    let data = try FlutterStandardEncoder().encode(points)
+    let value = try data.withUnsafeBytes { bytes in
+      try FlutterStandardDecoder().decode(FlutterStandardTypedArray<Float>.self, from: bytes)
+    }
+
+    XCTAssertFalse(value.isSharingMessageStorage)
+    XCTAssertEqual(Array(value), points)
+  }
+
+  func testRoundTripsInsideStruct() throws {
+    let cloud = PointCloud(
+      name: "lidar",
+      points: FlutterStandardTypedArray(points),
+      timestamps: FlutterStandardTypedArray([1, 2, 3])
+    )
+    let data = try FlutterStandardEncoder().encode(cloud)
+    let decoded = try FlutterStandardDecoder().decode(PointCloud.self, from: data)
+
+    XCTAssertEqual(decoded, cloud)
+    XCTAssertTrue(decoded.points.isSharingMessageStorage)
+    XCTAssertTrue(decoded.timestamps.isSharingMessageStorage)
+  }
+
+  func testWireFormatMatchesArray() throws {
+    let encoder = FlutterStandardEncoder()
+    XCTAssertEqual(
+      try encoder.encode(FlutterStandardTypedArray(points)),
+      try encoder.encode(points)
+    )
+    XCTAssertEqual(
+      try encoder.encode(FlutterStandardTypedArray<UInt8>([])),
+      try encoder.encode([UInt8]())
+    )
+    XCTAssertEqual(
+      try encoder.encode(["a": FlutterStandardTypedArray<Double>([1.5, 2.5])]),
+      try encoder.encode(["a": [1.5, 2.5]])
+    )
+  }
+
+  func testRejectsOtherTypedData() throws {
+    let data = try FlutterStandardEncoder().encode([1.5, 2.5])
+    XCTAssertThrowsError(
+      try FlutterStandardDecoder().decode(FlutterStandardTypedArray<Float>.self, from: data)
+    ) { error in
+      XCTAssertEqual(error as? FlutterSwiftError, .unexpectedStandardFieldType(.float64Data))
+    }
+  }
+}
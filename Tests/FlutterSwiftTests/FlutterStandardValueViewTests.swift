@@ -0,0 +1,333 @@
+//
+// Copyright (c) 2026 PADL Software Pty Ltd
+//
+// Licensed under the Apache License, Version 2.0 (the License);
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an 'AS IS' BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+@testable import FlutterSwift
+import Foundation
+import XCTest
+
+/// Covers `FlutterStandardValueView`, which reads individual values out of a
+/// message without materializing the rest of it.
+///
+/// What it has to get right is stepping over the values it does not read:
+/// a skip that consumes one byte too few or too many still finds the first
+/// key, so most of these place the interesting value after awkward neighbours
+/// (aligned floats, typed data, nested containers, escaped sizes).
+final class FlutterStandardValueViewTests: XCTestCase {
+  private let encoder = FlutterStandardEncoder()
+
+  // MARK: - scalars
+
+  func testReadsScalars() throws {
+    try withView(.true) { XCTAssertTrue(try $0.bool()) }
+    try withView(.false) { XCTAssertFalse(try $0.bool()) }
+    try withView(.int32(-7)) {
+      XCTAssertEqual(try $0.int32(), -7)
+      XCTAssertEqual(try $0.int(), -7)
+    }
+    try withView(.int64(.max)) {
+      XCTAssertEqual(try $0.int64(), .max)
+      XCTAssertEqual(try $0.field(), .int64)
+    }
+    try withView(.float64(.pi)) { XCTAssertEqual(try $0.double(), .pi) }
+    try withView(.string("h\u{263A}w")) { XCTAssertEqual(try $0.string(), "h\u{263A}w") }
+    try withView(.float64Data([1.5, -2.5])) {
+      XCTAssertEqual(try $0.array(of: Double.self), [1.5, -2.5])
+    }
+    try withView(.nil) { XCTAssertTrue($0.isNil) }
+  }
+
+  func testEmptyMessageIsNil() {
+    FlutterStandardValueView.withView(of: Data()) { view in
+      XCTAssertTrue(view.isNil)
+    }
+  }
+
+  func testTypeMismatchThrows() throws {
+    try withView(.string("x")) { view in
+      XCTAssertThrowsError(try view.int32()) { error in
+        XCTAssertEqual(error as? FlutterSwiftError, .unexpectedStandardFieldType(.string))
+      }
+    }
+  }
+
+  // MARK: - string lists
+
+  func testStringListSharesOneBuffer() throws {
+    let corpora: [[String]] = [
+      [],
+      ["", "a", ""],
+      (0..<50).map { "log line \($0): " + String(repeating: "x", count: $0) },
+      ["mixed caf\u{E9}", "\u{1F600} emoji", "plain ascii that is long enough"],
+      ["\u{6F22}\u{5B57}\u{304B}\u{306A}\u{30AB}\u{30CA}", "\u{D55C}\u{AD6D}\u{C5B4}", "\u{4E2D}\u{6587}"],
+    ]
+    for strings in corpora {
+      try withView(.list(strings.map { .string($0) })) { view in
+        let substrings = try view.stringList()
+        XCTAssertEqual(substrings.map(String.init), strings)
+        // every element is a slice of the whole list's bytes
+        let totalLength = strings.reduce(0) { $0 + $1.utf8.count }
+        for substring in substrings {
+          XCTAssertEqual(substring.base.utf8.count, totalLength)
+        }
+      }
+    }
+  }
+
+  /// Each element must be valid on its own, even where the concatenation
+  /// would be: here "\u{263A}" is split across two elements.
+  func testStringListRejectsSplitSequence() throws {
+    let bytes: [UInt8] = [0x0C, 0x02, 0x07, 0x02, 0xE2, 0x98, 0x07, 0x01, 0xBA]
+    FlutterStandardValueView.withView(of: Data(bytes)) { view in
+      XCTAssertThrowsError(try view.stringList()) { error in
+        XCTAssertEqual(error as? FlutterSwiftError, .stringNotDecodable(Data([0xE2, 0x98])))
+      }
+    }
+  }
+
+  func testStringListRejectsNonStrings() throws {
+    try withView(.list([.string("a"), .int32(1)])) { view in
+      XCTAssertThrowsError(try view.stringList()) { error in
+        XCTAssertEqual(error as? FlutterSwiftError, .unexpectedStandardFieldType(.int32))
+      }
+    }
+  }
+
+  // MARK: - maps
+
+  func testLooksUpKeysPastEveryShape() throws {
+    let message = AnyFlutterStandardCodable.map(Dictionary(
+      uniqueKeysWithValues: Self.awkwardValues.enumerated().map { index, value in
+        (AnyFlutterStandardCodable.string("key\(index)"), value)
+      }
+    ))
+    try withView(message) { view in
+      XCTAssertEqual(try view.count(), Self.awkwardValues.count)
+      for (index, value) in Self.awkwardValues.enumerated() {
+        let found = try XCTUnwrap(view.value(forKey: "key\(index)"))
+        XCTAssertEqual(try found.value(), value)
+      }
+      XCTAssertNil(try view.value(forKey: "missing"))
+      // a key that is a prefix of a real one must not match
+      XCTAssertNil(try view.value(forKey: "key"))
+    }
+  }
+
+  func testLooksUpNonStringKeys() throws {
+    let message = AnyFlutterStandardCodable.map([
+      .int32(1): .string("one"),
+      .list([.true]): .float64(2),
+      .string("three"): .int64Data([3]),
+    ])
+    try withView(message) { view in
+      XCTAssertEqual(try view.value(forKey: .int32(1))?.string(), "one")
+      XCTAssertEqual(try view.value(forKey: .list([.true]))?.double(), 2)
+      XCTAssertEqual(try view.value(forKey: .string("three"))?.array(of: Int64.self), [3])
+      XCTAssertNil(try view.value(forKey: .int32(2)))
+      // string lookups skip keys of other types rather than failing on them
+      XCTAssertEqual(try view.value(forKey: "three")?.array(of: Int64.self), [3])
+    }
+  }
+
+  func testNestedLookup() throws {
+    let message = AnyFlutterStandardCodable.map([
+      .string("noise"): .float64Data(Array(repeating: 1, count: 300)),
+      .string("display"): .map([
+        .string("name"): .string(String(repeating: "d", count: 400)),
+        .string("width"): .int32(1920),
+      ]),
+    ])
+    try withView(message) { view in
+      let display = try XCTUnwrap(view.value(forKey: "display"))
+      XCTAssertEqual(try display.value(forKey: "width")?.int(), 1920)
+    }
+  }
+
+  func testForEachEntryVisitsEveryEntry() throws {
+    let message = AnyFlutterStandardCodable.map([
+      .string("a"): .float64(1),
+      .int32(2): .list([.int32Data([1, 2]), .nil]),
+      .string("c"): .string("z"),
+    ])
+    var visited = [AnyFlutterStandardCodable: AnyFlutterStandardCodable]()
+    try withView(message) { view in
+      try view.forEachEntry { key, value in
+        let key = try key.value()
+        visited[key] = try value.value()
+      }
+    }
+    XCTAssertEqual(AnyFlutterStandardCodable.map(visited), message)
+  }
+
+  // MARK: - lists
+
+  func testIteratesAndIndexesLists() throws {
+    let message = AnyFlutterStandardCodable.list(Self.awkwardValues)
+    try withView(message) { view in
+      var elements = [AnyFlutterStandardCodable]()
+      try view.forEachElement { try elements.append($0.value()) }
+      XCTAssertEqual(elements, Self.awkwardValues)
+
+      for (index, value) in Self.awkwardValues.enumerated() {
+        XCTAssertEqual(try view.element(at: index).value(), value)
+      }
+      XCTAssertThrowsError(try view.element(at: Self.awkwardValues.count))
+    }
+  }
+
+  // MARK: - index
+
+  /// The index has to agree with the scanning lookup for every key, whatever
+  /// sits between the entries.
+  func testIndexAgreesWithScan() throws {
+    let message = AnyFlutterStandardCodable.map(Dictionary(
+      uniqueKeysWithValues: (0..<500).map { index in
+        (
+          AnyFlutterStandardCodable.string("key\(index)"),
+          Self.awkwardValues[index % Self.awkwardValues.count]
+        )
+      }
+    ))
+    try withView(message) { view in
+      let index = try view.makeIndex()
+      XCTAssertEqual(index.count, 500)
+      for i in 0..<500 {
+        let indexed = try XCTUnwrap(index.value(forKey: "key\(i)"))
+        let scanned = try XCTUnwrap(view.value(forKey: "key\(i)"))
+        XCTAssertEqual(indexed.offset, scanned.offset)
+        XCTAssertEqual(try indexed.value(), Self.awkwardValues[i % Self.awkwardValues.count])
+      }
+      XCTAssertNil(try index.value(forKey: "key500"))
+      XCTAssertNil(try index.value(forKey: ""))
+    }
+  }
+
+  /// Integer keys hash by value and width; every other non-string key shares
+  /// one hash and is told apart only by comparison.
+  func testIndexFindsNonStringKeys() throws {
+    let message = AnyFlutterStandardCodable.map([
+      .int32(1): .string("int32"),
+      .int64(1): .string("int64"),
+      .list([.true]): .string("list"),
+      .float64(1): .string("float64"),
+      .nil: .string("nil"),
+      .string("1"): .string("string"),
+    ])
+    try withView(message) { view in
+      let index = try view.makeIndex()
+      XCTAssertEqual(try index.value(forKey: .int32(1))?.string(), "int32")
+      XCTAssertEqual(try index.value(forKey: .int64(1))?.string(), "int64")
+      XCTAssertEqual(try index.value(forKey: .list([.true]))?.string(), "list")
+      XCTAssertEqual(try index.value(forKey: .float64(1))?.string(), "float64")
+      XCTAssertEqual(try index.value(forKey: .nil)?.string(), "nil")
+      XCTAssertEqual(try index.value(forKey: "1")?.string(), "string")
+      XCTAssertNil(try index.value(forKey: .int32(2)))
+      XCTAssertNil(try index.value(forKey: .list([.false])))
+    }
+  }
+
+  func testIndexOfEmptyMap() throws {
+    try withView(.map([:])) { view in
+      let index = try view.makeIndex()
+      XCTAssertEqual(index.count, 0)
+      XCTAssertNil(try index.value(forKey: "a"))
+    }
+  }
+
+  func testIndexRequiresMap() throws {
+    try withView(.list([])) { view in
+      XCTAssertThrowsError(try view.makeIndex()) { error in
+        XCTAssertEqual(error as? FlutterSwiftError, .unexpectedStandardFieldType(.list))
+      }
+    }
+  }
+
+  /// A map header claiming far more entries than the message has bytes for is
+  /// refused before the index allocates a table for them.
+  func testIndexRejectsImpossibleCount() {
+    let header: [UInt8] = [FlutterStandardField.map.rawValue, 255]
+    let count = UInt32(0x0FFF_FFFF)
+    let message = Data(header + withUnsafeBytes(of: count) { Array($0) } + [0, 0])
+    XCTAssertThrowsError(
+      try FlutterStandardValueView.withView(of: message) { try $0.makeIndex() }
+    ) { error in
+      XCTAssertEqual(error as? FlutterSwiftError, .eofTooEarly)
+    }
+  }
+
+  // MARK: - decoding
+
+  /// A view decodes a nested value as though it were the whole message, while
+  /// still measuring alignment from the true start of the message.
+  func testDecodesNestedValue() throws {
+    let message = AnyFlutterStandardCodable.list([
+      .int32(0),
+      .list([.float64(1.5), .float64Data([2.5])]),
+    ])
+    try withView(message) { view in
+      let nested = try view.element(at: 1)
+      XCTAssertEqual(
+        try nested.decode(AnyFlutterStandardCodable.self),
+        .list([.float64(1.5), .float64Data([2.5])])
+      )
+      let first = try nested.element(at: 0)
+      XCTAssertEqual(try first.decode(Double.self), 1.5)
+    }
+  }
+
+  // MARK: - malformed input
+
+  func testTruncatedMessageThrows() throws {
+    let encoded = try encoder.encode(
+      AnyFlutterStandardCodable.map([.string("a"): .string("long enough")])
+    )
+    let truncated = encoded.prefix(encoded.count - 3)
+    FlutterStandardValueView.withView(of: truncated) { view in
+      XCTAssertThrowsError(try view.value(forKey: "b"))
+    }
+  }
+
+  // MARK: - helpers
+
+  private func withView(
+    _ value: AnyFlutterStandardCodable,
+    _ body: (FlutterStandardValueView) throws -> ()
+  ) throws {
+    try FlutterStandardValueView.withView(of: encoder.encode(value), body)
+  }
+
+  /// Values whose sizes are easy to get wrong when skipping: aligned scalars,
+  /// typed data of every stride (empty ones included, which still carry
+  /// padding), escaped size prefixes and nested containers.
+  private static let awkwardValues: [AnyFlutterStandardCodable] = [
+    .nil,
+    .true,
+    .int32(1),
+    .int64(2),
+    .float64(3),
+    .string(""),
+    .string(String(repeating: "s", count: 300)),
+    .uint8Data([1, 2, 3]),
+    .int32Data([]),
+    .int32Data([4]),
+    .int64Data([5, 6]),
+    .float32Data([7]),
+    .float64Data([]),
+    .float64Data([8, 9]),
+    .list([.float64(10), .list([.int32Data([11])])]),
+    .map([.string("k"): .float64Data([12]), .int32(13): .nil]),
+    .int32(14),
+  ]
+}
@@ -20,6 +20,9 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
+import BinaryParsing
+@testable import FlutterSwift
+
 struct Simple: Codable, Hashable {
   let x: UInt8
   let y: UInt16
@@ -46,6 +49,99 @@ struct VariableSuffix: Codable, Hashable {
   let suffix: [UInt8]
 }
 
+/// A typical method-call argument struct, with hand-written
+/// `FlutterStandardEncodable` and `FlutterStandardDecodable` conformances
+/// alongside the synthesized `Codable` one that they have to agree with byte for
+/// byte.
+struct WindowArguments: Codable, Hashable, FlutterStandardEncodable, FlutterStandardDecodable {
+  let id: Int
+  let width: Int32
+  let height: UInt16
+  let scale: Double
+  let title: String
+  let subtitle: String?
+  let visible: Bool
+  let samples: [Float]
+  let inner: Composite.Inner
+
+  func write(to writer: inout FlutterStandardWriter) throws(FlutterSwiftError) {
+    writer.write(id)
+    writer.write(width)
+    writer.write(height)
+    writer.write(scale)
+    try writer.write(title)
+    if let subtitle {
+      try writer.write(subtitle)
+    } else {
+      writer.writeNil()
+    }
+    writer.write(visible)
+    try writer.write(samples)
+    // no conformance of its own; goes through `Encodable`
+    try writer.write(inner)
+  }
+
+  init(
+    id: Int,
+    width: Int32,
+    height: UInt16,
+    scale: Double,
+    title: String,
+    subtitle: String?,
+    visible: Bool,
+    samples: [Float],
+    inner: Composite.Inner
+  ) {
+    self.id = id
+    self.width = width
+    self.height = height
+    self.scale = scale
+    self.title = title
+    self.subtitle = subtitle
+    self.visible = visible
+    self.samples = samples
+    self.inner = inner
+  }
+
+  init(parsing input: inout ParserSpan) throws(ParsingError) {
+    id = try Int(parsingStandard: &input)
+    width = try Int32(parsingStandard: &input)
+    height = try UInt16(parsingStandard: &input)
+    scale = try Double(parsingStandard: &input)
+    title = try String(parsingStandard: &input)
+    subtitle = try input.parseStandardNil() ? nil : String(parsingStandard: &input)
+    visible = try Bool(parsingStandard: &input)
+    samples = try [Float](parsingStandard: &input)
+    // structs are positional, so a nested one is just its fields in line
+    inner = try Composite.Inner(value: Int8(parsingStandard: &input))
+  }
+
+  static let samples = [
+    WindowArguments(
+      id: 1,
+      width: 1920,
+      height: 1080,
+      scale: 1.5,
+      title: "main",
+      subtitle: nil,
+      visible: true,
+      samples: [],
+      inner: .init(value: -1)
+    ),
+    WindowArguments(
+      id: .max,
+      width: -1,
+      height: .max,
+      scale: .pi,
+      title: String(repeating: "t", count: 300),
+      subtitle: "h\u{263A}w",
+      visible: false,
+      samples: [1.5, -2.5, 3],
+      inner: .init(value: 42)
+    ),
+  ]
+}
+
 struct Generic<Value> {
   let value: Value
   let additional: UInt8